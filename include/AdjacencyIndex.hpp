@@ -0,0 +1,128 @@
+#pragma once
+
+#ifndef ADJACENCY_INDEX_HPP
+#define ADJACENCY_INDEX_HPP
+
+#include <cstdint>
+
+#include "MonotonicArena.hpp"
+
+#define MIN_BITSET_DEGREE (64)
+#define BITSET_DEGREE_DIVISOR (32)
+
+/**
+ * @brief Structure that answers whether a vertex id belongs to an adjacency. Small adjacencies keep
+ * their ids in a sorted array, searched in O(log d). Hubs switch to a bitset row over every id of the
+ * graph, searched in O(1); ids outside the row stay in the sorted array.
+ *
+ * When created with an arena, all of its memory comes from the arena, so it can live inside objects
+ * whose destructors are never called.
+ */
+class AdjacencyIndex
+{
+    private:
+        MonotonicArena* _arena;
+        int* _sorted;
+        int _size;
+        int _capacity;
+        uint64_t* _bits;
+        int _universe;
+
+        /**
+         * @brief Finds where an id is, or would be inserted, in the sorted array. The search gallops
+         * backwards from the end before the binary search, since ids are usually added in ascending order.
+         *
+         * @param id The id searched.
+         * @return The index of the first id not less than the searched one.
+         */
+        int GallopFromEnd(int id) const;
+
+        /**
+         * @brief Allocates memory from the arena, or with new when there is none.
+         *
+         * @tparam Type The type of the elements.
+         * @param count The number of elements.
+         * @return A pointer to the memory.
+         */
+        template <typename Type>
+        Type* AllocateArray(int count);
+
+        /**
+         * @brief Frees memory allocated by AllocateArray. Arena memory is only freed with the arena.
+         *
+         * @param array The memory freed.
+         */
+        template <typename Type>
+        void FreeArray(Type* array);
+
+    public:
+        /**
+         * @brief Constructor of an empty index.
+         *
+         * @param arena Arena where the index memory is allocated, or nullptr to allocate it with new.
+         */
+        AdjacencyIndex(MonotonicArena* arena = nullptr);
+
+        /**
+         * @brief Destructor responsible for freeing the memory not allocated in an arena.
+         */
+        ~AdjacencyIndex();
+
+        AdjacencyIndex(const AdjacencyIndex&) = delete;
+        AdjacencyIndex& operator=(const AdjacencyIndex&) = delete;
+
+        /**
+         * @brief Checks if an id was inserted.
+         *
+         * @param id The id searched.
+         * @return true if present, false otherwise.
+         */
+        bool Contains(int id) const;
+
+        /**
+         * @brief Inserts an id that is not present yet.
+         *
+         * @param id The id inserted.
+         */
+        void Insert(int id);
+
+        /**
+         * @brief Makes room for a number of ids in the sorted array, so they are inserted without growing it.
+         *
+         * @param capacity The number of ids.
+         */
+        void Reserve(int capacity);
+
+        /**
+         * @brief Moves the ids in [0, universe) to a bitset row. Does nothing if the index already has one.
+         *
+         * @param universe The number of ids covered by the row, usually the number of vertices.
+         */
+        void UseBitset(int universe);
+
+        /**
+         * @brief Checks if the index has a bitset row.
+         *
+         * @return true if it has, false otherwise.
+         */
+        bool IsBitset() const;
+
+        /**
+         * @brief Counts the bytes used by the sorted array and the bitset row.
+         *
+         * @return The number of bytes.
+         */
+        size_t MemoryBytes() const;
+
+        /**
+         * @brief Computes the degree from which a vertex uses a bitset row. A row over n vertices takes as
+         * much memory as a sorted array of n / 32 ids, so above that degree the row is both faster and
+         * smaller. Sparse graphs only give rows to their hubs, and dense graphs give them to most vertices.
+         *
+         * @param vertexCount The number of vertices of the graph.
+         * @return The minimum degree of a vertex with a bitset row.
+         */
+        static int BitsetThreshold(int vertexCount);
+};
+
+#endif
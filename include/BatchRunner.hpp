@@ -0,0 +1,128 @@
+#pragma once
+
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include <mutex>
+#include <deque>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <atomic>
+
+#include "OutputWriter.hpp"
+
+/**
+ * @brief Exception thrown when the directory or pattern of a batch does not match any file.
+ */
+class empty_batch_exception
+{};
+
+/**
+ * @brief Structure representing one input file of a batch and its answer.
+ */
+struct BatchJob
+{
+    std::string path;
+    size_t size;
+    std::string result;
+};
+
+/**
+ * @brief Verifies every graph file of a directory (or matched by a glob pattern) with a pool of
+ * threads. The files are sorted by size and dealt to the workers, so each one starts with the largest
+ * files of its own queue. A worker whose queue is empty steals the smallest file left in the queue of
+ * another worker, which keeps the threads busy until the end even when the sizes are very uneven.
+ *
+ * The answer of each file is exactly the line printed by the main program for it, and the answers are
+ * written in the order of the paths, whatever the order in which they were computed.
+ */
+class BatchRunner
+{
+    private:
+        /**
+         * @brief Queue of jobs of a worker, the largest files first.
+         */
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<size_t> jobs;
+        };
+
+        std::vector<BatchJob> _jobs;
+        std::vector<WorkerQueue> _queues;
+        int _firstCount;
+        std::atomic<long> _stolenCount;
+
+        /**
+         * @brief Lists the files of a directory or the files matched by a glob pattern, sorted by path.
+         *
+         * @param pattern The directory or the pattern.
+         * @return The paths found.
+         */
+        static std::vector<std::string> ExpandPattern(const char* pattern);
+
+        /**
+         * @brief Takes the next job of a worker: the largest one of its own queue or, if it is empty,
+         * the smallest one of another queue.
+         *
+         * @param worker The index of the worker.
+         * @param job Receives the index of the job taken.
+         * @return true if a job was taken, false if every queue is empty.
+         */
+        bool NextJob(int worker, size_t& job);
+
+        /**
+         * @brief Processes jobs until every queue is empty.
+         *
+         * @param worker The index of the worker.
+         */
+        void WorkerLoop(int worker);
+
+    public:
+        /**
+         * @brief Constructor responsible for finding the files and distributing them to the workers.
+         *
+         * @param pattern A directory, whose regular files are used, or a glob pattern.
+         * @param workerCount The number of worker threads.
+         * @param firstCount How many of the first ordered vertices to answer, or a negative number for all of them.
+         * @throw empty_batch_exception If no file is found.
+         */
+        BatchRunner(const char* pattern, int workerCount, int firstCount = -1);
+
+        /**
+         * @brief Verifies every file, blocking until all of them have an answer.
+         */
+        void Run();
+
+        /**
+         * @brief Writes one line "<path>: <answer>" per file, in the order of the paths.
+         *
+         * @param output The destination of the answers.
+         */
+        void WriteResults(OutputWriter& output);
+
+        /**
+         * @brief Counts the files of the batch.
+         *
+         * @return The number of files.
+         */
+        size_t FileCount();
+
+        /**
+         * @brief Returns a file of the batch, in the order of the paths.
+         *
+         * @param index The position of the file.
+         * @return The job with the path and, after Run, the answer (with its line break) of the file.
+         */
+        const BatchJob& GetJob(size_t index);
+
+        /**
+         * @brief Counts the jobs taken from the queue of another worker during the last run.
+         *
+         * @return The number of stolen jobs.
+         */
+        long StolenCount();
+};
+
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+
+#ifndef BINARY_PERMUTATION_HPP
+#define BINARY_PERMUTATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Graph.hpp"
+#include "OutputWriter.hpp"
+
+#define BINARY_PERMUTATION_MAGIC "GRDY"
+#define BINARY_PERMUTATION_VERSION (1)
+#define BINARY_PERMUTATION_GREEDY_FLAG (1)
+#define BINARY_PERMUTATION_HEADER_SIZE (16)
+
+/**
+ * @brief Exception thrown when a buffer does not hold a valid binary permutation.
+ */
+class invalid_binary_permutation_exception
+{};
+
+/**
+ * @brief Structure responsible for the binary output of the program, read by downstream stages
+ * without parsing text. All the fields are little-endian:
+ *
+ *   offset 0:  magic "GRDY" (4 bytes)
+ *   offset 4:  version (uint32)
+ *   offset 8:  flags (uint32), bit 0 set if the coloring is greedy
+ *   offset 12: number of ids (uint32)
+ *   offset 16: the ordered vertex ids (int32 each)
+ *
+ * Ids are only present when the coloring is greedy.
+ */
+class BinaryPermutation
+{
+    public:
+        /**
+         * @brief Computes the size in bytes of a binary permutation.
+         *
+         * @param count The number of ids.
+         * @return The size of the header plus the ids.
+         */
+        static size_t Size(int count);
+
+        /**
+         * @brief Writes a binary permutation to a buffered writer.
+         *
+         * @param writer The destination.
+         * @param isGreedy The verdict of the verification.
+         * @param graph The graph whose ordered vertices are written (ignored if not greedy). The first ones
+         * are selected without sorting the whole graph if its ordering is not cached (see Graph::VisitOrderedVertices).
+         * @param firstCount How many of the first vertices to write, or a negative number for all of them.
+         */
+        static void Write(OutputWriter& writer, bool isGreedy, Graph* graph, int firstCount = -1);
+
+        /**
+         * @brief Writes a binary permutation to a file through a memory mapping: the file is resized
+         * once and the ids are stored directly in the mapped pages.
+         *
+         * @param path The destination file, created or truncated.
+         * @param isGreedy The verdict of the verification.
+         * @param graph The graph whose ordered vertices are written (ignored if not greedy), as in Write.
+         * @param firstCount How many of the first vertices to write, or a negative number for all of them.
+         * @throw output_write_exception If the file cannot be created or mapped.
+         */
+        static void WriteMapped(const char* path, bool isGreedy, Graph* graph, int firstCount = -1);
+
+        /**
+         * @brief Reads a binary permutation from memory.
+         *
+         * @param data The bytes of the permutation.
+         * @param length The number of bytes.
+         * @param isGreedy Receives the verdict.
+         * @param count Receives the number of ids.
+         * @return A new array with the ids, which must be deleted by the caller.
+         * @throw invalid_binary_permutation_exception If the bytes are not a valid permutation.
+         */
+        static int* Read(const char* data, size_t length, bool& isGreedy, int& count);
+};
+
+#endif
@@ -0,0 +1,210 @@
+#pragma once
+
+#ifndef EXTERNAL_SORTER_HPP
+#define EXTERNAL_SORTER_HPP
+
+#include <cstdio>
+#include <cstddef>
+#include <vector>
+#include <sys/types.h>
+
+class Vertex;
+
+#define DEFAULT_EXTERNAL_MEMORY_BUDGET (64 * 1024 * 1024)
+
+// Maximum number of runs merged at once (see ExternalSorter)
+#define EXTERNAL_MERGE_FAN_IN (16)
+
+/**
+ * @brief Exception thrown when the temporary files used by the external sort cannot be
+ * created, written or read.
+ */
+class external_storage_exception
+{};
+
+/**
+ * @brief Record sorted by the ExternalSorter: the (color, id) key of a vertex and the vertex itself,
+ * so the caller gets it back from the merge without keeping its own lookup of all the vertices.
+ */
+struct SortRecord
+{
+    int color;
+    int id;
+    Vertex* vertex;
+};
+
+/**
+ * @brief Run of sorted records in a temporary file of the ExternalSorter: where its next record is and how
+ * many records are left.
+ */
+struct SortRun
+{
+    off_t offset;
+    long long count;
+};
+
+/**
+ * @brief Structure that sorts records by (color, id) in bounded memory. Records are accumulated
+ * until the memory budget is reached, then sorted and spilled as a run at the end of a temporary file.
+ * At the end, while there are more than EXTERNAL_MERGE_FAN_IN runs, each group of that many runs is
+ * merged into a single run of a second temporary file (a pass), and the files swap roles. The last
+ * runs are merged with a k-way merge as the records are read back in order, one at a time.
+ *
+ * Only two temporary files are used, however many runs there are. They are read and written with
+ * pread and pwrite into parts of the record buffer, so the budget covers every buffer of the merges.
+ * If every record fits in the budget, nothing is written to disk.
+ */
+class ExternalSorter
+{
+    private:
+        SortRecord* _buffer;
+        int _bufferLimit;
+        int _bufferCapacity;
+        int _bufferLength;
+        int _bufferPosition;
+
+        FILE* _storage[2];
+        int _storageIndex;
+        off_t _storageEnd;
+        std::vector<SortRun> _runs;
+        int _mergePasses;
+
+        FILE* _mergeStorage;
+        SortRun* _mergeRuns;
+        SortRecord** _mergeBuffers;
+        int* _mergeLengths;
+        int* _mergePositions;
+        int* _mergeHeap;
+        int _mergeHeapSize;
+        int _mergeBufferCapacity;
+
+        bool _finished;
+        bool _merging;
+
+        /**
+         * @brief Returns one of the two temporary files, creating it on first use.
+         *
+         * @param index The index of the file (0 or 1).
+         * @return The file.
+         * @throw external_storage_exception If the file could not be created.
+         */
+        FILE* Storage(int index);
+
+        /**
+         * @brief Sorts the records in memory and writes them as a new run at the end of the current file.
+         *
+         * @throw external_storage_exception If the run could not be written.
+         */
+        void SpillRun();
+
+        /**
+         * @brief Merges each group of EXTERNAL_MERGE_FAN_IN runs into a single run of the other file,
+         * which then becomes the current one.
+         *
+         * @throw external_storage_exception If a run could not be written or read.
+         */
+        void MergePass();
+
+        /**
+         * @brief Prepares the k-way merge of consecutive runs of a file, splitting the record buffer
+         * among them.
+         *
+         * @param storage The file with the runs.
+         * @param first The index of the first run.
+         * @param count The number of runs, at most EXTERNAL_MERGE_FAN_IN.
+         * @param bufferCapacity The number of records of the buffer of each run.
+         * @throw external_storage_exception If a run could not be read.
+         */
+        void StartMerge(FILE* storage, int first, int count, int bufferCapacity);
+
+        /**
+         * @brief Removes the smallest record from the merge.
+         *
+         * @param record Receives the record.
+         * @return true if a record was returned, false if the runs are exhausted.
+         * @throw external_storage_exception If a run could not be read.
+         */
+        bool PopMerged(SortRecord& record);
+
+        /**
+         * @brief Reads the next block of a run into its merge buffer.
+         *
+         * @param run The index of the run in the merge.
+         * @return true if records were read, false if the run is exhausted.
+         * @throw external_storage_exception If the run could not be read.
+         */
+        bool RefillRun(int run);
+
+        /**
+         * @brief Restores the merge heap property from a position towards the leaves.
+         *
+         * @param index The position to be fixed.
+         */
+        void SiftDown(int index);
+
+    public:
+        /**
+         * @brief Constructor responsible for initializing an empty sorter.
+         *
+         * @param memoryBudget Maximum number of bytes used to hold records in memory. Budgets smaller
+         * than EXTERNAL_MERGE_FAN_IN + 1 records are raised to that, the least a merge needs.
+         */
+        ExternalSorter(size_t memoryBudget);
+
+        /**
+         * @brief Destructor responsible for freeing the buffers and removing the temporary files.
+         */
+        ~ExternalSorter();
+
+        ExternalSorter(const ExternalSorter&) = delete;
+        ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+        /**
+         * @brief Adds a record to be sorted. Must not be called after Finish.
+         *
+         * @param record The record.
+         * @throw external_storage_exception If a run could not be written.
+         */
+        void Add(SortRecord record);
+
+        /**
+         * @brief Ends the insertion of records, merges the runs down to EXTERNAL_MERGE_FAN_IN and prepares
+         * the last merge. Every record is written when it returns, so a full disk or a missing temporary
+         * file is reported here rather than in the middle of the reads.
+         *
+         * @throw external_storage_exception If a run could not be written or read.
+         */
+        void Finish();
+
+        /**
+         * @brief Returns the next record in (color, id) order. Finish must be called first.
+         *
+         * @param record Receives the next record.
+         * @return true if a record was returned, false if all of them were already read.
+         * @throw external_storage_exception If a run could not be read.
+         */
+        bool Next(SortRecord& record);
+
+        /**
+         * @brief Counts the runs in temporary files, which after Finish are the runs of the last merge.
+         *
+         * @return The number of runs.
+         */
+        int RunCount();
+
+        /**
+         * @brief Counts the merge passes done by Finish before the last merge.
+         *
+         * @return The number of passes.
+         */
+        int MergePassCount();
+
+        /**
+         * @brief Compares two records, first by color and then by id.
+         *
+         * @return true if the first record must come before the second, false otherwise.
+         */
+        static bool IsLessThan(const SortRecord& first, const SortRecord& second);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#ifndef FILE_DESCRIPTOR_STREAM_HPP
+#define FILE_DESCRIPTOR_STREAM_HPP
+
+#include <cstddef>
+#include <streambuf>
+
+#define DEFAULT_INPUT_BUFFER_SIZE (1 << 16)
+
+/**
+ * @brief Stream buffer that reads from a file descriptor (such as a socket or a pipe), so the
+ * input of a connection can be consumed with a std::istream. The buffer can be reused for
+ * other descriptors through Reset.
+ */
+class FileDescriptorStreamBuffer : public std::streambuf
+{
+    private:
+        int _fileDescriptor;
+        char* _buffer;
+        size_t _capacity;
+
+    protected:
+        /**
+         * @brief Reads more data from the file descriptor when the buffer is exhausted.
+         *
+         * @return The next character, or EOF if the descriptor has no more data.
+         */
+        int_type underflow() override;
+
+    public:
+        /**
+         * @brief Constructor responsible for allocating the buffer.
+         *
+         * @param fileDescriptor The source of the data.
+         * @param capacity The size of the buffer in bytes.
+         */
+        FileDescriptorStreamBuffer(int fileDescriptor, size_t capacity = DEFAULT_INPUT_BUFFER_SIZE);
+
+        /**
+         * @brief Destructor responsible for freeing the buffer. The file descriptor is not closed.
+         */
+        ~FileDescriptorStreamBuffer();
+
+        /**
+         * @brief Discards the buffered data and starts reading from another file descriptor.
+         *
+         * @param fileDescriptor The new source of the data.
+         */
+        void Reset(int fileDescriptor);
+};
+
+#endif
@@ -4,10 +4,20 @@
 #define GRAPH_HPP
 
 #include <string>
+#include <vector>
+#include <iostream>
+#include <functional>
 
 #include "Vertex.hpp"
 #include "LinkedList.hpp"
+#include "MonotonicArena.hpp"
 #include "GraphOrderer.hpp"
+#include "VertexRelabeler.hpp"
+#include "OrderedVertexStream.hpp"
+#include "OutputWriter.hpp"
+
+// Number of slack tiers of the verification order (see Graph::SortByFailureLikelihood)
+#define SLACK_TIERS (4)
 
 /**
  * @brief Structure representing a graph and its dependencies (such as vertices and other properties).
@@ -16,20 +26,59 @@ class Graph
 {
     private:
         LinkedList<Vertex*>* _vertices;
+        LinkedList<Vertex*>* _orderedVertices;
         GraphOrderer* _orderer;
+        MonotonicArena* _arena;
+
+        /**
+         * @brief Discards the cached ordering, which must be computed again on the next request.
+         */
+        void InvalidateOrdering();
+
+        /**
+         * @brief Rejects in O(V) colorings that cannot be greedy without visiting any adjacency: a vertex
+         * with a color above its degree + 1 (it cannot have a neighbor of each smaller color), or a color
+         * c > 1 in use while no vertex has the color c - 1.
+         *
+         * @param candidates Receives the vertices that still must be verified (those with a color above 1).
+         * @return false if the coloring is certainly not greedy, true if the vertices must be verified.
+         */
+        bool PassesPreFilters(std::vector<Vertex*>& candidates);
+
+        /**
+         * @brief Sorts the vertices so the ones most likely to fail come first, by their slack: degree + 1
+         * minus the color, that is, how many neighbors are not needed to cover the smaller colors. A
+         * vertex with slack 0 fails if any two neighbors repeat a color. Slacks from SLACK_TIERS - 1 up
+         * are one tier and the sort is stable, so most vertices keep the order of the list. O(V).
+         *
+         * @param candidates The vertices, sorted in place.
+         */
+        static void SortByFailureLikelihood(std::vector<Vertex*>& candidates);
 
     public:
         /**
          * @brief Default constructor for the Graph class.
          * @param sortOption Character defining the sorting method to be used.
+         * @param arena Arena where the vertices, their adjacency lists and all list nodes are allocated,
+         * or nullptr to allocate each of them with new. It must not be used by another graph at the same time.
          */
-        Graph(char sortOption);
+        Graph(char sortOption, MonotonicArena* arena = nullptr);
 
         /**
-         * @brief Destructor responsible for freeing the memory allocated for a graph.
+         * @brief Destructor responsible for freeing the memory allocated for a graph. With an arena,
+         * the vertices are not visited: the arena is reset in one step and keeps its memory for the next graph.
          */
         ~Graph();
 
+        /**
+         * @brief Creates a new vertex in the arena of this graph (or with new, if it has none) and adds it.
+         * Graphs with an arena must only receive vertices created by this method.
+         *
+         * @param id The identifier of the vertex.
+         * @return A pointer to the new vertex.
+         */
+        Vertex* CreateVertex(int id);
+
         /**
          * @brief Adds a new vertex to this graph.
          *
@@ -61,6 +110,13 @@ class Graph
          */
         Vertex* GetVertex(int index);
 
+        /**
+         * @brief Returns the orderer used by this graph.
+         * 
+         * @return A pointer to the orderer.
+         */
+        GraphOrderer* GetOrderer();
+
         /**
          * @brief Checks if this graph is "greedy". That is, all vertices have a connection
          * with all colors smaller than their own coloring.
@@ -69,13 +125,68 @@ class Graph
          */
         bool IsGreedy();
 
+        /**
+         * @brief Returns the vertices in the order of the selected sorting method. The ordering is computed
+         * over a copy of the vertex list (the graph's own list keeps the insertion order) and cached until
+         * a vertex is added or colored through this graph. The returned list must not be modified.
+         * 
+         * @return A pointer to the cached list with the ordered vertices.
+         */
+        LinkedList<Vertex*>* GetOrderedVertices();
+
         /**
          * @brief Returns a string with the vertices ordered according to the selected sorting method.
+         * The ordering is cached, so repeated calls do not sort again, and it does not change the
+         * positions used by GetVertex.
          * 
          * @return A string with the ordered vertices.
          */
         std::string OrderedVertices();
 
+        /**
+         * @brief Returns a string with only the first vertices of OrderedVertices. If the sorting method
+         * reaches the full (color, id) order (see GraphOrderer::IsFullSort), they are selected without sorting
+         * the full list, in O(V + k log k); otherwise the list is sorted with the method and the first ones taken.
+         * 
+         * @param count The number (k) of vertices desired.
+         * 
+         * @return A string with the first ordered vertices.
+         */
+        std::string FirstOrderedVertices(int count);
+
+        /**
+         * @brief Visits the first vertices in the order of the selected sorting method, sorting no more
+         * than needed: the cached ordering is used if there is one, only the first vertices are selected
+         * when a count is given and the method is a full sort (see FirstOrderedVertices), so the result is
+         * always a prefix of OrderedVertices, and the external orderer ('e') visits them
+         * as its runs are merged, without a sorted copy of the list. Nothing is cached.
+         * 
+         * @param count How many of the first vertices to visit, or a negative number for all of them.
+         * @param start Called once the vertices are sorted, before the first one is visited (also when none
+         * is), so a caller that only writes from here writes nothing if the sort fails.
+         * @param visit Called with each vertex, in order.
+         * @throw external_storage_exception If the external orderer could not use its temporary files.
+         */
+        void VisitOrderedVertices(int count, const std::function<void()>& start, const std::function<void(Vertex*)>& visit);
+
+        /**
+         * @brief Writes the ordered vertex ids, separated by spaces, directly to a buffered writer,
+         * without building a string with the whole answer.
+         * 
+         * @param writer The destination of the ids.
+         * @param count How many of the first vertices to write, or a negative number for all of them.
+         * @param prefix Written before the ids, only once they are sorted (see VisitOrderedVertices).
+         */
+        void WriteOrderedVertices(OutputWriter& writer, int count = -1, const char* prefix = "");
+
+        /**
+         * @brief Creates a stream that yields the vertices of this graph in (color, id) order on demand.
+         * The colors must not change while the stream is used, and the caller must delete it.
+         * 
+         * @return A pointer to the new stream.
+         */
+        OrderedVertexStream* StreamOrderedVertices();
+
         /**
          * @brief Updates the coloring of a specific vertex in the graph.
          *
@@ -84,6 +195,24 @@ class Graph
          */
         void SetVertexColor(int index, int color);
 
+        /**
+         * @brief Replaces the colors of all vertices at once, without the checks of SetVertexColor, for
+         * colorings already validated elsewhere (see MultiColoringVerifier).
+         *
+         * @param colors The new color of the vertex at each position.
+         */
+        void ReplaceColors(const std::vector<int>& colors);
+
+        /**
+         * @brief Rebuilds the vertices of this graph in an order that places adjacent vertices close to
+         * each other in memory (see VertexRelabeler). The ids, adjacencies, colors and the order of the
+         * vertex list are kept, so the answers do not change, even for sort methods whose result depends on
+         * the order of the list ('y'), and GetVertex and SetVertexColor keep their positions.
+         *
+         * @param order The relabeling order.
+         */
+        void Relabel(RelabelOrder order);
+
         /**
          * @brief Counts the vertices in this graph.
          *
@@ -99,12 +228,26 @@ class Graph
         int EdgeCount();
 
         /**
-         * @brief Builds a graph based on the information provided by the standard input, 
-         * following the structure of the provided documentation.
+         * @brief Builds a graph based on the information provided by the standard input (or another
+         * input stream), following the structure of the provided documentation.
          *
+         * @param input The stream with the graph data.
+         * @param arena Arena used by the new graph, or nullptr to allocate each of its parts with new.
          * @return A pointer to the vertex with the new information.
+         * @throw element_not_found_exception If an adjacency line has an invalid id; the partial graph is freed.
+         */
+        static Graph* BuildFromIoStream(std::istream& input = std::cin, MonotonicArena* arena = nullptr);
+
+        /**
+         * @brief Builds a graph from the sort method, the vertex count and the adjacency lines of the
+         * input, leaving the stream at the color line and the vertices without colors.
+         *
+         * @param input The stream with the graph data.
+         * @param arena Arena used by the new graph, or nullptr to allocate each of its parts with new.
+         * @return A pointer to the new graph.
+         * @throw element_not_found_exception If an adjacency line has an invalid id; the partial graph is freed.
          */
-        static Graph* BuildFromIoStream();
+        static Graph* BuildTopologyFromIoStream(std::istream& input, MonotonicArena* arena = nullptr);
 
         /**
          * @brief Prints the graph information to the standard output.
@@ -0,0 +1,214 @@
+#pragma once
+
+#ifndef GRAPH_GENERATOR_HPP
+#define GRAPH_GENERATOR_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include "Graph.hpp"
+#include "OutputWriter.hpp"
+
+#define DENSE_EDGE_PROBABILITY (0.25)
+
+/**
+ * @brief Exception thrown when a graph model is unknown or its parameters are invalid.
+ */
+class invalid_graph_model_exception
+{};
+
+/**
+ * @brief Function that receives each generated edge, as a pair of vertices.
+ */
+typedef std::function<void(int, int)> EdgeVisitor;
+
+/**
+ * @brief Random graph models available in the generator.
+ */
+enum GraphModel
+{
+    ERDOS_RENYI,
+    POWER_LAW,
+    DENSE,
+    GRID
+};
+
+/**
+ * @brief Structure that generates random graphs with a greedy coloring, for benchmarks and tests.
+ *
+ * The edges are kept in compressed sparse rows (offsets and neighbors), so graphs with millions of
+ * vertices can be produced in O(V + E) time and memory before being converted to a Graph or written
+ * in the input format of the program. The coloring is computed with first fit over a random order of
+ * the vertices, which always results in a greedy coloring. The same model, size, degree and seed
+ * always produce the same graph.
+ */
+class GraphGenerator
+{
+    private:
+        int _vertexCount;
+        std::vector<int64_t> _offsets;
+        std::vector<int> _neighbors;
+        std::vector<int> _colors;
+        uint64_t _state;
+
+        /**
+         * @brief Generates the next pseudorandom number (xorshift64*).
+         *
+         * @return A 64-bit number.
+         */
+        uint64_t NextRandom();
+
+        /**
+         * @brief Generates a pseudorandom number in [0, 1).
+         *
+         * @return The number.
+         */
+        double NextUniform();
+
+        /**
+         * @brief Generates a G(n, p) graph, skipping geometrically between the edges (Batagelj and Brandes).
+         *
+         * @param probability The probability of each edge.
+         * @param visit Receives each edge.
+         */
+        void GenerateUniform(double probability, const EdgeVisitor& visit);
+
+        /**
+         * @brief Generates a graph by preferential attachment (Barabási and Albert), whose degrees follow a power law.
+         *
+         * @param edgesPerVertex The number of edges added with each new vertex.
+         * @param visit Receives each edge.
+         */
+        void GeneratePreferential(int edgesPerVertex, const EdgeVisitor& visit);
+
+        /**
+         * @brief Generates a square lattice where each cell is adjacent to the cells within a distance
+         * in both directions. The ids are a random permutation of the cells, so the structure has
+         * locality that the order of the ids does not show.
+         *
+         * @param radius The distance of the neighbors in each direction.
+         * @param labels The id of each cell, in row-major order.
+         * @param visit Receives each edge.
+         */
+        void GenerateGrid(int radius, const std::vector<int>& labels, const EdgeVisitor& visit);
+
+        /**
+         * @brief Builds the compressed rows from a generator of edges, which is run twice from the same state.
+         *
+         * @param generate Function that generates the edges, passing each one to the visitor it receives.
+         */
+        void BuildRows(const std::function<void(const EdgeVisitor&)>& generate);
+
+        /**
+         * @brief Colors the vertices with first fit over a random order of the vertices.
+         */
+        void ColorGreedily();
+
+    public:
+        /**
+         * @brief Constructor responsible for generating the graph and its coloring.
+         *
+         * @param model The random model.
+         * @param vertexCount The number of vertices.
+         * @param averageDegree The expected average degree. Ignored by DENSE, where each edge exists with DENSE_EDGE_PROBABILITY.
+         * GRID uses the square window closest to it ((2r + 1)² - 1 neighbors, with r at least 1).
+         * @param seed The seed of the pseudorandom numbers.
+         * @throw invalid_graph_model_exception If a parameter is invalid.
+         */
+        GraphGenerator(GraphModel model, int vertexCount, double averageDegree, uint64_t seed);
+
+        /**
+         * @brief Converts the name of a model ("er", "powerlaw", "dense" or "grid") to the model.
+         *
+         * @param name The name.
+         * @return The model.
+         * @throw invalid_graph_model_exception If the name is unknown.
+         */
+        static GraphModel ParseModel(const std::string& name);
+
+        /**
+         * @brief Returns the name of a model, as accepted by ParseModel.
+         *
+         * @param model The model.
+         * @return The name.
+         */
+        static const char* ModelName(GraphModel model);
+
+        /**
+         * @brief Creates a Graph with the generated vertices, edges and colors, in O(V + E).
+         *
+         * @param sortOption The sorting method of the graph.
+         * @param arena Arena used by the new graph, or nullptr to allocate each of its parts with new.
+         * @return A pointer to the new graph, which must be deleted by the caller.
+         */
+        Graph* BuildGraph(char sortOption, MonotonicArena* arena = nullptr);
+
+        /**
+         * @brief Writes the graph in the input format of the program.
+         *
+         * @param output The destination of the text.
+         * @param sortOption The sorting method written in the first line.
+         */
+        void Write(OutputWriter& output, char sortOption);
+
+        /**
+         * @brief Recolors a random vertex with a color two above the highest color of its neighbors.
+         * The coloring stays proper, but is no longer greedy, since the color right below is missing
+         * from the neighbors of that vertex.
+         *
+         * @return The id of the recolored vertex.
+         */
+        int BreakGreedy();
+
+        /**
+         * @brief Checks if the current coloring is greedy, in O(V + E).
+         *
+         * @return true if every vertex has a neighbor of each smaller color and none of its own color, false otherwise.
+         */
+        bool IsGreedyColoring();
+
+        /**
+         * @brief Writes the answer the program gives for the graph: 0, or 1 followed by the vertices
+         * ordered by color and id. For a sorting method that does not reach that order ('y', see
+         * GraphOrderer::IsFullSort), the vertices are sorted with the method itself.
+         *
+         * @param output The destination of the text.
+         * @param sortOption The sorting option of the instance (see Write).
+         * @param firstCount How many vertices are written (-k), or a negative number for all of them.
+         * @throw invalid_orderer_option_exception If the sorting option is invalid.
+         */
+        void WriteExpected(OutputWriter& output, char sortOption, int firstCount = -1);
+
+        /**
+         * @brief Counts the vertices of the graph.
+         *
+         * @return The number of vertices.
+         */
+        int VertexCount();
+
+        /**
+         * @brief Counts the edges of the graph.
+         *
+         * @return The number of edges.
+         */
+        int64_t EdgeCount();
+
+        /**
+         * @brief Counts the colors used by the coloring.
+         *
+         * @return The number of colors.
+         */
+        int ColorCount();
+
+        /**
+         * @brief Returns the color of a vertex.
+         *
+         * @param vertex The id of the vertex.
+         * @return The color, starting at 1.
+         */
+        int GetColor(int vertex);
+};
+
+#endif
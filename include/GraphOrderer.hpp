@@ -3,9 +3,23 @@
 #ifndef LISTORDERER_HPP
 #define LISTORDERER_HPP
 
+#include <string>
+#include <cstddef>
+#include <functional>
+
 #include "Vertex.hpp"
 #include "LinkedList.hpp"
 
+#define AUTO_ORDERER_OPTION ('a')
+#define EXTERNAL_ORDERER_OPTION ('e')
+
+// Options of the sorting methods (see GraphOrderer::SortWith)
+#define SORT_OPTIONS "bsiqmpylvnte"
+
+// Options of the sorting methods that do not always reach the full (color, id) order, so their result
+// depends on the order of the list (see GraphOrderer::IsFullSort)
+#define PARTIAL_SORT_OPTIONS "y"
+
 /**
  * @brief Exception thrown when the option indicating the chosen sorting method
  * is invalid.
@@ -21,7 +35,10 @@ class GraphOrderer
 {
     private:
         char _option;
-        LinkedList<Vertex*>* (*_ordererMethod)(LinkedList<Vertex*>* list);
+        char _chosenOption;
+        std::string _choiceReason;
+
+        static size_t _externalMemoryBudget;
 
         /**
          * @brief Applies the BubbleSort method to sort a list.
@@ -81,12 +98,75 @@ class GraphOrderer
         static LinkedList<Vertex*>* CustomSort(LinkedList<Vertex*>* list);
 
         /**
-         * @brief Sets the sorting method to be called by the Sort function. It initializes a function pointer
-         * that will receive the chosen method.
+         * @brief Applies a MergeSort that works directly on the linked list, relinking its nodes
+         * instead of accessing them by index. The nodes are kept, only their order changes.
          * 
-         * @param option Chosen sorting method.
+         * @param list The list to be sorted.
+         * @return A pointer to the sorted list.
+        */
+        static LinkedList<Vertex*>* LinkedMergeSort(LinkedList<Vertex*>* list);
+
+        /**
+         * @brief Sorts a list by packing each vertex into a 64-bit key (color << 32) | id and sorting
+         * the keys with SIMD instructions when available (see PackedKeySorter). If the ids are negative
+         * or too sparse to be indexed, LinkedMergeSort is used instead.
+         * 
+         * @param list The list to be sorted.
+         * @return A pointer to the sorted list.
+        */
+        static LinkedList<Vertex*>* PackedKeySort(LinkedList<Vertex*>* list);
+
+        /**
+         * @brief Applies the IntroSort method (pattern-defeating quicksort) to sort a list. It uses
+         * median-of-three or ninther pivots, insertion sort for small ranges, falls back to HeapSort
+         * after 2 * log n levels and detects already sorted or reversed inputs, so it is O(n log n)
+         * in the worst case with a bounded recursion depth.
+         * 
+         * @param list The list to be sorted.
+         * @return A pointer to the sorted list.
+        */
+        static LinkedList<Vertex*>* IntroSort(LinkedList<Vertex*>* list);
+
+        /**
+         * @brief Applies the TimSort method to sort a list. It is an adaptive and stable sort that
+         * detects natural ascending/descending runs, extends short runs with binary insertion and
+         * merges them with galloping, being close to O(n) on nearly sorted lists and O(n log n)
+         * in the worst case.
+         * 
+         * @param list The list to be sorted.
+         * @return A pointer to the sorted list.
+        */
+        static LinkedList<Vertex*>* TimSort(LinkedList<Vertex*>* list);
+
+        /**
+         * @brief Sorts a list in bounded memory (see ExternalSorter): runs that fit in the memory budget
+         * are sorted and spilled to temporary files, then merged back into the list with a k-way merge
+         * (see VisitExternalSort).
+         * 
+         * @param list The list to be sorted.
+         * @return A pointer to the sorted list.
+        */
+        static LinkedList<Vertex*>* ExternalSort(LinkedList<Vertex*>* list);
+
+        /**
+         * @brief Applies the sorting method of an option to a list. The comparison sorts are instantiations
+         * of OrdererEngine, so the option only selects which one runs: inside it, every comparison is inlined.
+         * 
+         * @param option The option of the sorting method, other than the automatic one.
+         * @param list The list to be sorted.
+         * @return A pointer to the sorted list.
+         * @throw invalid_orderer_option_exception If the option is unknown.
         */
-        void SelectSortMethod(char option);
+        static LinkedList<Vertex*>* SortWith(char option, LinkedList<Vertex*>* list);
+
+        /**
+         * @brief Chooses the sorting method for a list when the automatic option ('a') is selected.
+         * The choice is based on the number of vertices, how presorted the list is (natural runs) and
+         * the density of the ids, and is recorded with its reason.
+         * 
+         * @param list The list that will be sorted.
+        */
+        void ChooseSortMethod(LinkedList<Vertex*>* list);
 
     public:
         /**
@@ -103,6 +183,68 @@ class GraphOrderer
          * @return A pointer to the sorted list.
         */
         LinkedList<Vertex*>* Sort(LinkedList<Vertex*>* list);
+
+        /**
+         * @brief Returns the sorting method applied by the last call to Sort. It only differs from the option
+         * given in the constructor for the automatic option ('a').
+         * 
+         * @return The option of the sorting method used.
+        */
+        char GetChosenOption();
+
+        /**
+         * @brief Returns why the automatic option chose its sorting method in the last call to Sort.
+         * 
+         * @return A description of the choice, or an empty string if the option is not automatic.
+        */
+        std::string GetChoiceReason();
+
+        /**
+         * @brief Selects the first vertices of a list in (color, id) order, without sorting the
+         * whole list: a quickselect isolates the smallest ones in O(n) and only they are sorted,
+         * resulting in O(n + k log k). The list itself is not modified.
+         * 
+         * @param list The list with the vertices.
+         * @param count The number (k) of vertices desired.
+         * @param result Array with at least count positions that receives the selected vertices, in order.
+         * @return The number of vertices written to result (the smallest between count and the list length).
+        */
+        static int SelectFirst(LinkedList<Vertex*>* list, int count, Vertex** result);
+
+        /**
+         * @brief Returns the option given in the constructor.
+         * 
+         * @return The option of the chosen sorting method, or the automatic option ('a').
+        */
+        char GetOption();
+
+        /**
+         * @brief Checks if the chosen sorting method always results in the full (color, id) order, so its
+         * first vertices are the ones found by SelectFirst.
+         * 
+         * @return true for every method except the ones of PARTIAL_SORT_OPTIONS, false otherwise.
+        */
+        bool IsFullSort();
+
+        /**
+         * @brief Visits the vertices of a list in (color, id) order with the external orderer ('e'), as
+         * its runs are merged. The list is not modified and nothing proportional to its length is
+         * allocated: only the records within the memory budget and the temporary files.
+         * 
+         * @param list The list with the vertices.
+         * @param start Called once every run is written and merged down to the last merge, so the failures
+         * of the temporary files are reported before it (see ExternalSorter::Finish).
+         * @param visit Called with each vertex, in order. The list is only read before start is called.
+         * @throw external_storage_exception If the temporary files could not be written or read.
+        */
+        static void VisitExternalSort(LinkedList<Vertex*>* list, const std::function<void()>& start, const std::function<void(Vertex*)>& visit);
+
+        /**
+         * @brief Sets the memory budget used by the external orderer ('e').
+         * 
+         * @param bytes Maximum number of bytes used to hold sort records in memory.
+        */
+        static void SetExternalMemoryBudget(size_t bytes);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#ifndef GRAPH_PIPELINE_HPP
+#define GRAPH_PIPELINE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <istream>
+
+#include "Graph.hpp"
+#include "SpscQueue.hpp"
+#include "OutputWriter.hpp"
+
+#define DEFAULT_PIPELINE_DEPTH (4)
+
+/**
+ * @brief Structure representing a graph on its way through the pipeline.
+ *
+ * An item with a graph carries the result of its verification, an item with an error carries the
+ * message that replaces its answer, and an item with neither marks the end of the input.
+ */
+struct PipelineItem
+{
+    Graph* graph;
+    bool isGreedy;
+    const char* error;
+};
+
+/**
+ * @brief Processes a sequence of graphs read from a stream with three concurrent stages: a thread
+ * parses graph N+1 while another verifies and sorts graph N and the calling thread writes the answer
+ * of graph N-1. The stages are connected by bounded lock-free queues (SpscQueue), so a fast stage stops
+ * when its queue is full instead of keeping an unbounded number of graphs in memory, and the answers
+ * are written in the same order as the graphs, exactly as GraphRunner would write them one by one.
+ */
+class GraphPipeline
+{
+    private:
+        std::istream& _input;
+        OutputWriter& _output;
+        int _firstCount;
+
+        SpscQueue<PipelineItem> _parsed;
+        SpscQueue<PipelineItem> _verified;
+        std::atomic<bool> _cancelled;
+
+        /**
+         * @brief Adds an item to a queue, waiting while it is full.
+         *
+         * @param queue The destination queue.
+         * @param item The item to be added.
+         * @return true if the item was added, false if the pipeline was cancelled.
+         */
+        bool Push(SpscQueue<PipelineItem>& queue, const PipelineItem& item);
+
+        /**
+         * @brief Removes an item from a queue, waiting while it is empty.
+         *
+         * @param queue The source queue.
+         * @param item Receives the item removed.
+         * @return true if an item was removed, false if the pipeline was cancelled.
+         */
+        bool Pop(SpscQueue<PipelineItem>& queue, PipelineItem& item);
+
+        /**
+         * @brief First stage: reads the graphs until the end of the stream or the first malformed one.
+         */
+        void ParseStage();
+
+        /**
+         * @brief Second stage: verifies each graph and, when the whole order is needed, sorts it.
+         */
+        void VerifyStage();
+
+        /**
+         * @brief Last stage: writes the answers, flushing the output whenever no answer is ready.
+         *
+         * @return The number of answers written.
+         */
+        long OutputStage();
+
+    public:
+        /**
+         * @brief Constructor responsible for creating the queues between the stages.
+         *
+         * @param input The stream with the graphs, one after the other.
+         * @param output The destination of the answers.
+         * @param firstCount How many of the first ordered vertices to write, or a negative number for all of them.
+         * @param depth How many graphs each queue can hold.
+         */
+        GraphPipeline(std::istream& input, OutputWriter& output, int firstCount = -1, size_t depth = DEFAULT_PIPELINE_DEPTH);
+
+        /**
+         * @brief Processes every graph of the stream, blocking until the last answer is written. After a
+         * malformed graph the position in the stream is unknown, so its error is the last answer.
+         *
+         * @return The number of answers written.
+         * @throw output_write_exception If the output could not be written.
+         */
+        long Run();
+};
+
+#endif
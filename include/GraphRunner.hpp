@@ -0,0 +1,67 @@
+#pragma once
+
+#ifndef GRAPH_RUNNER_HPP
+#define GRAPH_RUNNER_HPP
+
+#include <iostream>
+
+#include "Graph.hpp"
+#include "OutputWriter.hpp"
+#include "MonotonicArena.hpp"
+
+/**
+ * @brief Exception thrown when the stream ends or has malformed data before the graph is complete.
+ */
+class malformed_input_exception
+{};
+
+/**
+ * @brief Structure that processes a complete request: builds a graph from a stream, verifies it and
+ * writes the same line printed by the main program. It is shared by the modes that handle several
+ * graphs in one process (server, batch and pipeline).
+ */
+class GraphRunner
+{
+    public:
+        /**
+         * @brief Reads a graph from the stream and writes its answer: "1 <ordered ids>" if the
+         * coloring is greedy, "0" otherwise, or the description of the error that happened, followed
+         * by a line break.
+         *
+         * @param input The stream with the graph data.
+         * @param output The destination of the answer.
+         * @param firstCount How many of the first ordered vertices to write, or a negative number for all of them.
+         * @param arena Arena reused by the graphs of the caller, or nullptr to allocate each part of the graph with new.
+         * @return true if the graph was processed, false if an error was described instead.
+         */
+        static bool Run(std::istream& input, OutputWriter& output, int firstCount = -1, MonotonicArena* arena = nullptr);
+
+        /**
+         * @brief Reads a graph from the stream, checking that it was complete.
+         *
+         * @param input The stream with the graph data.
+         * @param arena Arena used by the new graph, or nullptr to allocate each of its parts with new.
+         * @return A pointer to the new graph, which must be deleted by the caller.
+         * @throw malformed_input_exception If the stream ended or had invalid data before the graph was complete.
+         */
+        static Graph* Build(std::istream& input, MonotonicArena* arena = nullptr);
+
+        /**
+         * @brief Writes the answer of a graph already verified, followed by a line break.
+         *
+         * @param graph The graph.
+         * @param isGreedy The result of the verification of the graph.
+         * @param output The destination of the answer.
+         * @param firstCount How many of the first ordered vertices to write, or a negative number for all of them.
+         */
+        static void WriteAnswer(Graph* graph, bool isGreedy, OutputWriter& output, int firstCount = -1);
+
+        /**
+         * @brief Describes the exception being handled. Must be called inside a catch block.
+         *
+         * @return The message shown to the user for the exception.
+         */
+        static const char* DescribeCurrentException();
+};
+
+#endif
@@ -0,0 +1,138 @@
+#pragma once
+
+#ifndef GRAPH_SERVER_HPP
+#define GRAPH_SERVER_HPP
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <istream>
+#include <condition_variable>
+
+#include "OutputWriter.hpp"
+#include "MonotonicArena.hpp"
+
+#define STATS_COMMAND "#stats"
+
+// Latencies are counted in buckets whose bounds grow by 2^(1/8), about 9%, from 1 µs up to 2^40 µs
+#define LATENCY_BUCKETS_PER_DOUBLING (8)
+#define LATENCY_BUCKET_COUNT (40 * LATENCY_BUCKETS_PER_DOUBLING + 1)
+
+/**
+ * @brief Exception thrown when the server socket cannot be created, bound or listened on.
+ */
+class server_socket_exception
+{};
+
+/**
+ * @brief Long-running server that verifies graphs received through a Unix domain socket.
+ *
+ * Each connection sends one or more graphs in the same text format read by the main program and
+ * receives one answer line per graph, in order. Connections are handled by a fixed pool of worker
+ * threads, each one with its own reusable input and output buffers. The line STATS_COMMAND can be sent
+ * instead of a graph to receive the number of requests served and their latency percentiles.
+ */
+class GraphServer
+{
+    private:
+        std::string _socketPath;
+        int _workerCount;
+        int _firstCount;
+
+        int _listener;
+        std::atomic<bool> _running;
+
+        std::thread _acceptor;
+        std::vector<std::thread> _workers;
+
+        std::mutex _connectionsMutex;
+        std::condition_variable _connectionsSignal;
+        std::deque<int> _pendingConnections;
+        std::vector<int> _activeConnections;
+
+        std::mutex _latenciesMutex;
+        long _latencyBuckets[LATENCY_BUCKET_COUNT];
+        long _requestCount;
+        double _maxLatency;
+
+        /**
+         * @brief Accepts new connections and hands them to the workers, until the server stops.
+         */
+        void AcceptLoop();
+
+        /**
+         * @brief Serves connections taken from the queue, until the server stops.
+         */
+        void WorkerLoop();
+
+        /**
+         * @brief Waits for the next pending connection.
+         *
+         * @return The connection, or a negative number if the server stopped.
+         */
+        int NextConnection();
+
+        /**
+         * @brief Answers every request of a connection, until it is closed by the client.
+         *
+         * @param input The reusable input stream of the worker, already reading the connection.
+         * @param output The reusable output buffer of the worker, already writing to the connection.
+         * @param arena The arena of the worker, reused by every graph it builds.
+         */
+        void ServeConnection(std::istream& input, OutputWriter& output, MonotonicArena& arena);
+
+        /**
+         * @brief Records the latency of a request in the histogram, in constant time and memory.
+         *
+         * @param microseconds The time spent to answer the request.
+         */
+        void RecordLatency(double microseconds);
+
+    public:
+        /**
+         * @brief Constructor responsible for initializing the server, without starting it.
+         *
+         * @param socketPath The path of the Unix domain socket.
+         * @param workerCount The number of worker threads.
+         * @param firstCount How many of the first ordered vertices to answer, or a negative number for all of them.
+         */
+        GraphServer(const char* socketPath, int workerCount, int firstCount = -1);
+
+        /**
+         * @brief Destructor responsible for stopping the server if it is running.
+         */
+        ~GraphServer();
+
+        /**
+         * @brief Creates the socket and starts the acceptor and the worker threads. Returns immediately.
+         *
+         * @throw server_socket_exception If the socket cannot be created.
+         */
+        void Start();
+
+        /**
+         * @brief Stops accepting connections, closes the open ones, waits for the threads and removes the socket.
+         */
+        void Stop();
+
+        /**
+         * @brief Counts the requests (graphs) answered so far.
+         *
+         * @return The number of requests.
+         */
+        long RequestCount();
+
+        /**
+         * @brief Estimates a percentile of the latency of the requests answered so far, as the upper
+         * bound of its histogram bucket (at most 9% above the exact value). The maximum is exact.
+         *
+         * @param percentile The desired percentile, between 0 and 100.
+         * @return The latency in microseconds, or 0 if no request was answered.
+         */
+        double LatencyPercentile(double percentile);
+};
+
+#endif
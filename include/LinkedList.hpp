@@ -3,6 +3,9 @@
 #ifndef LINKED_LIST_HPP
 #define LINKED_LIST_HPP
 
+#include "Stats.hpp"
+#include "MonotonicArena.hpp"
+
 /**
  * @brief Exception thrown when an operation is performed on an empty list, or invalid access
  * to an item occurs.
@@ -49,6 +52,7 @@ class LinkedList
         Node<DataType>* _tail;
 
         int _size;
+        MonotonicArena* _arena;
 
         int _lastGetIndex = -1;
         Node<DataType>* _lastGetNode = nullptr;
@@ -82,6 +86,9 @@ class LinkedList
                 }
             }
 
+            STATS_COUNT(STATS_LINEAR_WALKS);
+            STATS_ADD(STATS_WALK_LENGTH, index <= _size / 2 ? index : _size - 1 - index);
+
             _lastGetIndex = index;
             _lastGetNode = current;
 
@@ -94,21 +101,28 @@ class LinkedList
          * @brief Default constructor for the LinkedList class.
          *
          * Creates a new instance of LinkedList with an empty list.
+         *
+         * @param arena Arena where the nodes are allocated, or nullptr to allocate each one with new.
          */
-        LinkedList()
+        LinkedList(MonotonicArena* arena = nullptr)
         {
             _head = nullptr;
             _tail = nullptr;
             _size = 0;
+            _arena = arena;
         };
 
         /**
          * @brief Destructor for the LinkedList class.
          *
          * Frees the memory allocated for the elements of the list and destroys the list instance.
+         * Nodes allocated in an arena are left to it.
          */
         ~LinkedList()
         {
+            if (_arena != nullptr)
+                return;
+
             auto current = _head;
 
             for(int i = 0; i < _size; i++)
@@ -140,7 +154,7 @@ class LinkedList
          */
         void Insert(DataType data)
         {
-            Node<DataType>* newNode = new Node<DataType>();
+            Node<DataType>* newNode = _arena == nullptr ? new Node<DataType>() : _arena->Create<Node<DataType>>();
             newNode->data = data;
 
             newNode->next = nullptr;
@@ -235,10 +249,14 @@ class LinkedList
                 return LinearGet(index);
                 
             if (_lastGetIndex == index) 
+            {
+                STATS_COUNT(STATS_CURSOR_HITS);
                 return _lastGetNode;
+            }
 
             if (_lastGetIndex == index - 1)
             {
+                STATS_COUNT(STATS_CURSOR_HITS);
                 _lastGetIndex = index;
                 _lastGetNode = _lastGetNode->next;
 
@@ -247,6 +265,7 @@ class LinkedList
 
             if (_lastGetIndex == index + 1)
             {
+                STATS_COUNT(STATS_CURSOR_HITS);
                 _lastGetIndex = index;
                 _lastGetNode = _lastGetNode->previous;
 
@@ -267,6 +286,7 @@ class LinkedList
             if (first == nullptr || second == nullptr)
                 return;
 
+            STATS_COUNT(STATS_SWAPS);
             DataType temp = first->data;
 
             first->data = second->data;
@@ -286,6 +306,87 @@ class LinkedList
 
             node->data = newData;
         }
+
+        /**
+         * @brief Sorts the list in place by relinking the next/previous references of its nodes
+         * (bottom-up merge sort). The nodes themselves are preserved, so pointers to them held by
+         * the caller remain valid and keep their content. The sort is stable, runs in O(n log n)
+         * and requires O(1) additional memory.
+         *
+         * @param lessOrEqual Function (or function object) returning true if the first element must stay before the second.
+         */
+        template <typename LessOrEqual>
+        void SortNodes(LessOrEqual lessOrEqual)
+        {
+            if (_size < 2)
+                return;
+
+            Node<DataType>* list = _head;
+
+            for (int width = 1; width < _size; width *= 2)
+            {
+                Node<DataType>* left = list;
+                Node<DataType>* tail = nullptr;
+                list = nullptr;
+
+                while (left != nullptr)
+                {
+                    Node<DataType>* right = left;
+                    int leftSize = 0;
+
+                    while (leftSize < width && right != nullptr)
+                    {
+                        right = right->next;
+                        leftSize++;
+                    }
+
+                    int rightSize = width;
+
+                    while (leftSize > 0 || (rightSize > 0 && right != nullptr))
+                    {
+                        Node<DataType>* chosen;
+
+                        if (leftSize == 0)
+                        {
+                            chosen = right;
+                            right = right->next;
+                            rightSize--;
+                        }
+                        else if (rightSize == 0 || right == nullptr || lessOrEqual(left->data, right->data))
+                        {
+                            chosen = left;
+                            left = left->next;
+                            leftSize--;
+                        }
+                        else
+                        {
+                            chosen = right;
+                            right = right->next;
+                            rightSize--;
+                        }
+
+                        chosen->previous = tail;
+
+                        if (tail == nullptr)
+                            list = chosen;
+                        else
+                            tail->next = chosen;
+
+                        tail = chosen;
+                    }
+
+                    left = right;
+                }
+
+                tail->next = nullptr;
+                _tail = tail;
+            }
+
+            _head = list;
+
+            _lastGetIndex = -1;
+            _lastGetNode = nullptr;
+        }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef MAPPED_FILE_STREAM_HPP
+#define MAPPED_FILE_STREAM_HPP
+
+#include <cstddef>
+#include <streambuf>
+
+/**
+ * @brief Exception thrown when the input file cannot be opened or mapped in memory (for example,
+ * when it is a pipe instead of a regular file).
+ */
+class mapped_file_exception
+{};
+
+/**
+ * @brief Stream buffer over a file mapped read-only in memory, so it can be consumed with a
+ * std::istream without copying it. Unlike FileDescriptorStreamBuffer, it can seek anywhere in the
+ * file, which lets the same input be read more than once.
+ */
+class MappedFileStreamBuffer : public std::streambuf
+{
+    private:
+        char* _mapping;
+        size_t _size;
+
+    protected:
+        /**
+         * @brief Moves the read position relative to the beginning, the current position or the end.
+         *
+         * @param offset The offset from the reference position.
+         * @param direction The reference position.
+         * @param mode Ignored, only reading is supported.
+         * @return The new position, or -1 if it is outside the file.
+         */
+        pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode = std::ios_base::in) override;
+
+        /**
+         * @brief Moves the read position to an absolute position.
+         *
+         * @param position The new position.
+         * @param mode Ignored, only reading is supported.
+         * @return The new position, or -1 if it is outside the file.
+         */
+        pos_type seekpos(pos_type position, std::ios_base::openmode mode = std::ios_base::in) override;
+
+    public:
+        /**
+         * @brief Constructor responsible for mapping the file.
+         *
+         * @param path The path of the file.
+         * @throw mapped_file_exception If the file cannot be opened or mapped.
+         */
+        MappedFileStreamBuffer(const char* path);
+
+        /**
+         * @brief Destructor responsible for unmapping the file.
+         */
+        ~MappedFileStreamBuffer();
+
+        MappedFileStreamBuffer(const MappedFileStreamBuffer&) = delete;
+        MappedFileStreamBuffer& operator=(const MappedFileStreamBuffer&) = delete;
+
+        /**
+         * @brief Returns the size of the file.
+         *
+         * @return The number of bytes.
+         */
+        size_t Size();
+};
+
+#endif
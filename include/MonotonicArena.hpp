@@ -0,0 +1,124 @@
+#pragma once
+
+#ifndef MONOTONIC_ARENA_HPP
+#define MONOTONIC_ARENA_HPP
+
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#define DEFAULT_ARENA_BLOCK_SIZE (1 << 16)
+
+/**
+ * @brief Structure that allocates memory by advancing a pointer inside large blocks. Nothing is freed
+ * individually: Reset discards every allocation at once and keeps the blocks for the next use, so a
+ * structure with millions of small objects is destroyed in O(1) instead of one delete per object.
+ *
+ * The objects created in an arena never have their destructors called, so they must not own memory
+ * outside of it. An arena is not thread safe.
+ */
+class MonotonicArena
+{
+    private:
+        /**
+         * @brief A block of memory owned by the arena.
+         */
+        struct ArenaBlock
+        {
+            char* memory;
+            size_t size;
+        };
+
+        std::vector<ArenaBlock> _blocks;
+        size_t _currentBlock;
+        char* _next;
+        char* _end;
+
+        /**
+         * @brief Allocates from the next block that has room, creating a bigger block if none has.
+         *
+         * @param size The number of bytes.
+         * @param alignment The alignment of the memory, a power of two.
+         * @return A pointer to the memory.
+         */
+        void* AllocateSlow(size_t size, size_t alignment);
+
+        /**
+         * @brief Makes a block the current one, with all of its memory available.
+         *
+         * @param index The index of the block.
+         */
+        void UseBlock(size_t index);
+
+    public:
+        /**
+         * @brief Constructor responsible for allocating the first block.
+         *
+         * @param blockSize The size of the first block. The following ones double in size.
+         */
+        MonotonicArena(size_t blockSize = DEFAULT_ARENA_BLOCK_SIZE);
+
+        /**
+         * @brief Destructor responsible for freeing every block.
+         */
+        ~MonotonicArena();
+
+        MonotonicArena(const MonotonicArena&) = delete;
+        MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+        /**
+         * @brief Allocates memory that lives until the next Reset.
+         *
+         * @param size The number of bytes.
+         * @param alignment The alignment of the memory, a power of two.
+         * @return A pointer to the memory.
+         * @throw std::bad_alloc If a new block cannot be allocated.
+         */
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+        {
+            uintptr_t address = ((uintptr_t)_next + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+            if (address + size > (uintptr_t)_end)
+                return AllocateSlow(size, alignment);
+
+            _next = (char*)(address + size);
+            return (void*)address;
+        }
+
+        /**
+         * @brief Constructs an object in the arena. Its destructor is never called.
+         *
+         * @tparam Type The type of the object.
+         * @param arguments The arguments of the constructor.
+         * @return A pointer to the new object.
+         */
+        template <class Type, class... Arguments>
+        Type* Create(Arguments&&... arguments)
+        {
+            return new (Allocate(sizeof(Type), alignof(Type))) Type(std::forward<Arguments>(arguments)...);
+        }
+
+        /**
+         * @brief Discards every allocation. The memory is kept for the next allocations, merged into a
+         * single block when more than one was needed, so the next use of the same size does not allocate.
+         */
+        void Reset();
+
+        /**
+         * @brief Counts the bytes handed out since the last Reset, including the alignment padding.
+         *
+         * @return The number of bytes.
+         */
+        size_t UsedBytes();
+
+        /**
+         * @brief Counts the bytes of all blocks owned by the arena.
+         *
+         * @return The number of bytes.
+         */
+        size_t ReservedBytes();
+};
+
+#endif
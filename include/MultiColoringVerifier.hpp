@@ -0,0 +1,121 @@
+#pragma once
+
+#ifndef MULTI_COLORING_VERIFIER_HPP
+#define MULTI_COLORING_VERIFIER_HPP
+
+#include <vector>
+#include <istream>
+
+#include "Graph.hpp"
+#include "OutputWriter.hpp"
+
+#define COLORING_BLOCK_SIZE (8)
+
+/**
+ * @brief Result of a coloring: greedy or not, or the error that reading it with
+ * Graph::BuildFromIoStream would have raised.
+ */
+enum ColoringVerdict
+{
+    COLORING_GREEDY,
+    COLORING_NOT_GREEDY,
+    COLORING_INVALID_COLOR,
+    COLORING_UNAVAILABLE_COLOR
+};
+
+/**
+ * @brief Verifies many colorings of the same graph. The adjacency lines are read once, and the
+ * colorings are verified in blocks: the colors of a block are interleaved by vertex, so each visit
+ * to a neighbor reads its color in every coloring of the block at once, and the adjacency lists are
+ * traversed once per block instead of once per coloring.
+ *
+ * Each answer is exactly the line the program writes for the graph with that coloring, including the
+ * errors of Graph::SetVertexColor, which are checked in the same pass.
+ */
+class MultiColoringVerifier
+{
+    private:
+        Graph* _graph;
+        int _blockSize;
+        int _maxDegree;
+
+        // Adjacency of each vertex position, as compressed rows of neighbor positions
+        std::vector<int> _offsets;
+        std::vector<int> _neighbors;
+
+        // _block[v * _blockSize + b] is the color of the vertex v in the coloring b of the block
+        std::vector<int> _block;
+
+        // Scratch arrays of the verification, with one row per coloring of the block
+        std::vector<int> _seen;
+        std::vector<int> _missing;
+        std::vector<char> _conflict;
+
+    public:
+        /**
+         * @brief Constructor responsible for copying the adjacencies of the graph as compressed rows.
+         *
+         * @param graph A graph whose vertex ids are their positions, as built by Graph::BuildTopologyFromIoStream.
+         * It is recolored to write the ordered vertices of the greedy colorings, and must outlive the verifier.
+         * @param blockSize The number of colorings verified in each traversal of the adjacencies.
+         */
+        MultiColoringVerifier(Graph* graph, int blockSize = COLORING_BLOCK_SIZE);
+
+        /**
+         * @brief Returns the number of colorings verified together.
+         *
+         * @return The size of a block.
+         */
+        int BlockSize();
+
+        /**
+         * @brief Puts a coloring in a slot of the block.
+         *
+         * @param slot The slot, in [0, BlockSize()).
+         * @param colors The color of each vertex position.
+         */
+        void LoadColoring(int slot, const std::vector<int>& colors);
+
+        /**
+         * @brief Reads the next colorings of the stream, one color per vertex, into the block.
+         *
+         * @param input The stream, positioned after the adjacency lines or the previous colorings.
+         * @return The number of complete colorings read. The stream fails if the last one was incomplete
+         * or had invalid data, and reaches its end without failing if there were no more colorings.
+         */
+        int ReadBlock(std::istream& input);
+
+        /**
+         * @brief Verifies the first colorings of the block.
+         *
+         * @param count The number of colorings, at most BlockSize().
+         * @return The verdict of each coloring.
+         */
+        std::vector<ColoringVerdict> VerifyBlock(int count);
+
+        /**
+         * @brief Writes the answer of a coloring of the block, followed by a line break. The ordered
+         * vertices of a greedy coloring are written by the graph, with its sort method.
+         *
+         * @param slot The slot of the coloring.
+         * @param verdict The verdict of the coloring.
+         * @param output The destination of the answer.
+         * @param firstCount How many of the first ordered vertices to write, or a negative number for all of them.
+         */
+        void WriteAnswer(int slot, ColoringVerdict verdict, OutputWriter& output, int firstCount = -1);
+
+        /**
+         * @brief Reads a graph followed by any number of color lines and writes one answer per coloring,
+         * in order. An error in the adjacency lines or an incomplete coloring ends the input, with its
+         * description as the last answer.
+         *
+         * @param input The stream with the sort method, the vertex count, the adjacency lines and the color lines.
+         * @param output The destination of the answers.
+         * @param firstCount How many of the first ordered vertices to write, or a negative number for all of them.
+         * @param blockSize The number of colorings verified in each traversal of the adjacencies.
+         * @return The number of answers written.
+         */
+        static long Run(std::istream& input, OutputWriter& output, int firstCount = -1, int blockSize = COLORING_BLOCK_SIZE);
+};
+
+#endif
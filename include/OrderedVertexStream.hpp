@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef ORDERED_VERTEX_STREAM_HPP
+#define ORDERED_VERTEX_STREAM_HPP
+
+#include "Vertex.hpp"
+#include "LinkedList.hpp"
+
+/**
+ * @brief Exception thrown when a vertex is requested from a stream that has no vertices left.
+ */
+class stream_exhausted_exception
+{};
+
+/**
+ * @brief Structure that yields the vertices of a list in (color, id) order on demand. It is built
+ * in O(n) (binary heap over a copy of the list) and each vertex requested costs O(log n), so
+ * reading only the first k vertices does not pay for sorting the whole list.
+ *
+ * The colors of the vertices must not change while the stream is being consumed.
+ */
+class OrderedVertexStream
+{
+    private:
+        Vertex** _heap;
+        int _size;
+
+        /**
+         * @brief Restores the heap property from a position towards the leaves.
+         *
+         * @param index The position to be fixed.
+         */
+        void SiftDown(int index);
+
+    public:
+        /**
+         * @brief Constructor responsible for building the heap with the vertices of a list.
+         *
+         * @param list The list with the vertices. It is not modified.
+         */
+        OrderedVertexStream(LinkedList<Vertex*>* list);
+
+        /**
+         * @brief Destructor responsible for freeing the memory allocated for the heap.
+         */
+        ~OrderedVertexStream();
+
+        /**
+         * @brief Checks if there are vertices left in the stream.
+         *
+         * @return true if another vertex can be requested, false otherwise.
+         */
+        bool HasNext();
+
+        /**
+         * @brief Returns the next vertex in (color, id) order, removing it from the stream.
+         *
+         * @return A pointer to the next vertex.
+         * @throw stream_exhausted_exception If there are no vertices left.
+         */
+        Vertex* Next();
+
+        /**
+         * @brief Counts the vertices left in the stream.
+         *
+         * @return The number of vertices not yet returned.
+         */
+        int Remaining();
+};
+
+#endif
@@ -0,0 +1,893 @@
+#pragma once
+
+#ifndef ORDERER_ENGINE_HPP
+#define ORDERER_ENGINE_HPP
+
+#include <cstdint>
+#include <functional>
+
+#include "Vertex.hpp"
+#include "Stats.hpp"
+
+#define INSERTION_SORT_THRESHOLD (16)
+#define NINTHER_THRESHOLD (128)
+#define PARTIAL_INSERTION_SORT_LIMIT (8)
+
+#define TIM_SORT_MIN_MERGE (32)
+#define TIM_SORT_MIN_GALLOP (7)
+#define TIM_SORT_MAX_RUNS (85)
+
+/**
+ * @brief Key of a vertex in the order of the answer: its color and then its id, packed in a single integer
+ * so two vertices are compared with one instruction. The id is shifted by INT32_MIN, so negative ids
+ * keep their order below the positive ones.
+ */
+struct VertexKey
+{
+    int64_t operator()(Vertex* vertex) const
+    {
+        return (int64_t)vertex->GetColor() * ((int64_t)1 << 32) + ((int64_t)vertex->GetId() - INT32_MIN);
+    }
+};
+
+/**
+ * @brief A vertex with its key computed in advance, so the sorts compare keys stored next to each other
+ * instead of reading two vertices scattered in memory for each comparison.
+ */
+struct KeyedVertex
+{
+    int64_t key;
+    Vertex* vertex;
+};
+
+/**
+ * @brief Key of a KeyedVertex, already computed.
+ */
+struct StoredKey
+{
+    int64_t operator()(const KeyedVertex& item) const
+    {
+        return item.key;
+    }
+};
+
+/**
+ * @brief Sorting algorithms of GraphOrderer written once for any array of items, a key extraction
+ * (KeyOf, item to key) and a strict order of the keys (Less). Every comparison is a call to the
+ * function objects received as types, so each instantiation is compiled with the comparisons inlined,
+ * instead of calling an out-of-line method of the items through a function pointer.
+ *
+ * Each algorithm makes the same comparisons as its original version on the linked list, so the resulting
+ * order is the same, including the one of the items with equal keys.
+ *
+ * @tparam Item The type of the items (e.g. Vertex*).
+ * @tparam KeyOf Function object returning the key of an item.
+ * @tparam Less Function object returning true if the first key must come before the second.
+ */
+template <typename Item, typename KeyOf, typename Less = std::less<int64_t>>
+class OrdererEngine
+{
+    private:
+        /**
+         * @brief State of a TimSort execution: the array, the auxiliary buffer used by the merges and
+         * the stack of pending runs.
+         */
+        struct TimSortState
+        {
+            Item* array;
+            Item* buffer;
+            int minGallop;
+
+            int runBase[TIM_SORT_MAX_RUNS];
+            int runLength[TIM_SORT_MAX_RUNS];
+            int runCount;
+        };
+
+        static void Swap(Item* array, int first, int second)
+        {
+            STATS_COUNT(STATS_SWAPS);
+
+            Item temp = array[first];
+            array[first] = array[second];
+            array[second] = temp;
+        }
+
+        static void QuickSortRecursive(Item* array, int start, int end)
+        {
+            if (start >= end)
+                return;
+
+            Item pivot = array[start];
+
+            int count = 0;
+            for (int i = start + 1; i <= end; i++)
+            {
+                if (IsLessThanOrEqual(array[i], pivot))
+                    count++;
+            }
+
+            int pivotIndex = start + count;
+            Swap(array, pivotIndex, start);
+
+            int i = start, j = end;
+
+            while (i < pivotIndex && j > pivotIndex)
+            {
+                while (IsLessThanOrEqual(array[i], pivot))
+                    i++;
+
+                while (IsBiggerThan(array[j], pivot))
+                    j--;
+
+                if (i < pivotIndex && j > pivotIndex)
+                    Swap(array, i++, j--);
+            }
+
+            QuickSortRecursive(array, start, pivotIndex - 1);
+            QuickSortRecursive(array, pivotIndex + 1, end);
+        }
+
+        static void MergeSortRecursive(Item* array, Item* buffer, int begin, int end)
+        {
+            if (begin >= end)
+                return;
+
+            int mid = begin + (end - begin) / 2;
+
+            MergeSortRecursive(array, buffer, begin, mid);
+            MergeSortRecursive(array, buffer, mid + 1, end);
+
+            for (int i = begin; i <= end; i++)
+                buffer[i] = array[i];
+
+            int left = begin, right = mid + 1, merged = begin;
+
+            while (left <= mid && right <= end)
+                array[merged++] = IsLessThanOrEqual(buffer[left], buffer[right]) ? buffer[left++] : buffer[right++];
+
+            while (left <= mid)
+                array[merged++] = buffer[left++];
+
+            while (right <= end)
+                array[merged++] = buffer[right++];
+        }
+
+        static void Heapify(Item* array, int length, int root)
+        {
+            while (true)
+            {
+                int largest = root;
+                int left = 2 * root + 1;
+                int right = 2 * root + 2;
+
+                if (left < length && IsBiggerThan(array[left], array[largest]))
+                    largest = left;
+
+                if (right < length && IsBiggerThan(array[right], array[largest]))
+                    largest = right;
+
+                if (largest == root)
+                    return;
+
+                Swap(array, root, largest);
+                root = largest;
+            }
+        }
+
+        static void InsertionSortRange(Item* array, int begin, int end)
+        {
+            for (int i = begin + 1; i < end; i++)
+            {
+                Item current = array[i];
+
+                int j = i - 1;
+                while (j >= begin && IsLess(current, array[j]))
+                {
+                    array[j + 1] = array[j];
+                    j--;
+                }
+                array[j + 1] = current;
+            }
+        }
+
+        static bool PartialInsertionSortRange(Item* array, int begin, int end)
+        {
+            int moves = 0;
+
+            for (int i = begin + 1; i < end; i++)
+            {
+                Item current = array[i];
+
+                int j = i - 1;
+                while (j >= begin && IsLess(current, array[j]))
+                {
+                    array[j + 1] = array[j];
+                    j--;
+                }
+                array[j + 1] = current;
+
+                moves += i - 1 - j;
+                if (moves > PARTIAL_INSERTION_SORT_LIMIT)
+                    return false;
+            }
+
+            return true;
+        }
+
+        static void HeapSiftDown(Item* array, int begin, int length, int root)
+        {
+            while (true)
+            {
+                int largest = root;
+                int left = 2 * root + 1;
+                int right = left + 1;
+
+                if (left < length && IsLess(array[begin + largest], array[begin + left]))
+                    largest = left;
+
+                if (right < length && IsLess(array[begin + largest], array[begin + right]))
+                    largest = right;
+
+                if (largest == root)
+                    return;
+
+                Swap(array, begin + root, begin + largest);
+                root = largest;
+            }
+        }
+
+        static void HeapSortRange(Item* array, int begin, int end)
+        {
+            int length = end - begin;
+
+            for (int i = length / 2 - 1; i >= 0; i--)
+                HeapSiftDown(array, begin, length, i);
+
+            for (int i = length - 1; i > 0; i--)
+            {
+                Swap(array, begin, begin + i);
+                HeapSiftDown(array, begin, i, 0);
+            }
+        }
+
+        static void SortThree(Item* array, int first, int second, int third)
+        {
+            if (IsLess(array[second], array[first]))
+                Swap(array, first, second);
+
+            if (IsLess(array[third], array[second]))
+                Swap(array, second, third);
+
+            if (IsLess(array[second], array[first]))
+                Swap(array, first, second);
+        }
+
+        static void IntroSortChoosePivot(Item* array, int begin, int end)
+        {
+            int length = end - begin;
+            int mid = begin + length / 2;
+
+            if (length > NINTHER_THRESHOLD)
+            {
+                SortThree(array, begin, mid, end - 1);
+                SortThree(array, begin + 1, mid - 1, end - 2);
+                SortThree(array, begin + 2, mid + 1, end - 3);
+                SortThree(array, mid - 1, mid, mid + 1);
+            }
+            else
+            {
+                SortThree(array, begin, mid, end - 1);
+            }
+
+            Swap(array, begin, mid);
+        }
+
+        static int IntroSortPartition(Item* array, int begin, int end, bool& alreadyPartitioned)
+        {
+            Item pivot = array[begin];
+            int i = begin + 1;
+            int j = end - 1;
+
+            while (i <= j && IsLess(array[i], pivot))
+                i++;
+
+            while (i <= j && !IsLess(array[j], pivot))
+                j--;
+
+            alreadyPartitioned = i > j;
+
+            while (i < j)
+            {
+                Swap(array, i++, j--);
+
+                while (i <= j && IsLess(array[i], pivot))
+                    i++;
+
+                while (i <= j && !IsLess(array[j], pivot))
+                    j--;
+            }
+
+            int pivotIndex = i - 1;
+            Swap(array, begin, pivotIndex);
+
+            return pivotIndex;
+        }
+
+        static int IntroSortDepthLimit(int length)
+        {
+            int depthLimit = 0;
+            for (int n = length; n > 1; n >>= 1)
+                depthLimit += 2;
+
+            return depthLimit;
+        }
+
+        static void IntroSortLoop(Item* array, int begin, int end, int depthLimit)
+        {
+            while (end - begin > INSERTION_SORT_THRESHOLD)
+            {
+                if (depthLimit == 0)
+                {
+                    HeapSortRange(array, begin, end);
+                    return;
+                }
+                depthLimit--;
+
+                IntroSortChoosePivot(array, begin, end);
+
+                bool alreadyPartitioned;
+                int pivotIndex = IntroSortPartition(array, begin, end, alreadyPartitioned);
+
+                // Probably a sorted run: tries to finish both sides with a bounded insertion sort
+                if (alreadyPartitioned &&
+                    PartialInsertionSortRange(array, begin, pivotIndex) &&
+                    PartialInsertionSortRange(array, pivotIndex + 1, end))
+                    return;
+
+                // Recursion only on the smaller side, keeping the stack depth logarithmic
+                if (pivotIndex - begin < end - pivotIndex - 1)
+                {
+                    IntroSortLoop(array, begin, pivotIndex, depthLimit);
+                    begin = pivotIndex + 1;
+                }
+                else
+                {
+                    IntroSortLoop(array, pivotIndex + 1, end, depthLimit);
+                    end = pivotIndex;
+                }
+            }
+
+            InsertionSortRange(array, begin, end);
+        }
+
+        static int TimSortMinRunLength(int length)
+        {
+            int remainder = 0;
+
+            while (length >= TIM_SORT_MIN_MERGE)
+            {
+                remainder |= length & 1;
+                length >>= 1;
+            }
+
+            return length + remainder;
+        }
+
+        static int TimSortCountRun(Item* array, int begin, int end)
+        {
+            int runEnd = begin + 1;
+            if (runEnd == end)
+                return 1;
+
+            // Only strictly descending runs are reversed, keeping the sort stable
+            if (IsLess(array[runEnd++], array[begin]))
+            {
+                while (runEnd < end && IsLess(array[runEnd], array[runEnd - 1]))
+                    runEnd++;
+
+                for (int i = begin, j = runEnd - 1; i < j; i++, j--)
+                    Swap(array, i, j);
+            }
+            else
+            {
+                while (runEnd < end && !IsLess(array[runEnd], array[runEnd - 1]))
+                    runEnd++;
+            }
+
+            return runEnd - begin;
+        }
+
+        static void BinaryInsertionSort(Item* array, int begin, int end, int start)
+        {
+            for (int i = start; i < end; i++)
+            {
+                Item pivot = array[i];
+
+                int left = begin;
+                int right = i;
+                while (left < right)
+                {
+                    int mid = left + (right - left) / 2;
+
+                    if (IsLess(pivot, array[mid]))
+                        right = mid;
+                    else
+                        left = mid + 1;
+                }
+
+                for (int j = i; j > left; j--)
+                    array[j] = array[j - 1];
+
+                array[left] = pivot;
+            }
+        }
+
+        /**
+         * @brief Counts the items of array[base, base + length) that are less than the key (or less than
+         * or equal to it, if inclusive is true). Searches exponentially from the beginning.
+         */
+        static int TimSortGallop(Item key, Item* array, int base, int length, bool inclusive)
+        {
+            int last = 0;
+            int offset = 1;
+
+            auto before = [&](Item current) {
+                return inclusive ? !IsLess(key, current) : IsLess(current, key);
+            };
+
+            if (length == 0 || !before(array[base]))
+                return 0;
+
+            while (offset < length && before(array[base + offset]))
+            {
+                last = offset;
+                offset = offset * 2 + 1;
+
+                if (offset <= 0)
+                    offset = length;
+            }
+
+            if (offset > length)
+                offset = length;
+
+            last++;
+            while (last < offset)
+            {
+                int mid = last + (offset - last) / 2;
+
+                if (before(array[base + mid]))
+                    last = mid + 1;
+                else
+                    offset = mid;
+            }
+
+            return offset;
+        }
+
+        static void TimSortMergeRuns(TimSortState& state, int base1, int length1, int base2, int length2)
+        {
+            Item* array = state.array;
+            Item* buffer = state.buffer;
+
+            for (int i = 0; i < length1; i++)
+                buffer[i] = array[base1 + i];
+
+            int cursor1 = 0;
+            int cursor2 = base2;
+            int end2 = base2 + length2;
+            int destiny = base1;
+
+            while (cursor1 < length1 && cursor2 < end2)
+            {
+                int count1 = 0;
+                int count2 = 0;
+
+                // One item at a time, until a run starts winning consistently
+                while (cursor1 < length1 && cursor2 < end2)
+                {
+                    if (IsLess(array[cursor2], buffer[cursor1]))
+                    {
+                        array[destiny++] = array[cursor2++];
+                        count1 = 0;
+
+                        if (++count2 >= state.minGallop)
+                            break;
+                    }
+                    else
+                    {
+                        array[destiny++] = buffer[cursor1++];
+                        count2 = 0;
+
+                        if (++count1 >= state.minGallop)
+                            break;
+                    }
+                }
+
+                // Galloping mode: moves whole blocks found by exponential search
+                while (cursor1 < length1 && cursor2 < end2)
+                {
+                    int block1 = TimSortGallop(array[cursor2], buffer, cursor1, length1 - cursor1, true);
+                    for (int i = 0; i < block1; i++)
+                        array[destiny++] = buffer[cursor1++];
+
+                    if (cursor1 == length1)
+                        break;
+
+                    array[destiny++] = array[cursor2++];
+                    if (cursor2 == end2)
+                        break;
+
+                    int block2 = TimSortGallop(buffer[cursor1], array, cursor2, end2 - cursor2, false);
+                    for (int i = 0; i < block2; i++)
+                        array[destiny++] = array[cursor2++];
+
+                    if (cursor2 == end2)
+                        break;
+
+                    array[destiny++] = buffer[cursor1++];
+
+                    if (block1 < TIM_SORT_MIN_GALLOP && block2 < TIM_SORT_MIN_GALLOP)
+                    {
+                        state.minGallop++;
+                        break;
+                    }
+
+                    if (state.minGallop > 1)
+                        state.minGallop--;
+                }
+            }
+
+            while (cursor1 < length1)
+                array[destiny++] = buffer[cursor1++];
+        }
+
+        static void TimSortMergeAt(TimSortState& state, int index)
+        {
+            int base1 = state.runBase[index];
+            int length1 = state.runLength[index];
+            int base2 = state.runBase[index + 1];
+            int length2 = state.runLength[index + 1];
+
+            state.runLength[index] = length1 + length2;
+            if (index == state.runCount - 3)
+            {
+                state.runBase[index + 1] = state.runBase[index + 2];
+                state.runLength[index + 1] = state.runLength[index + 2];
+            }
+            state.runCount--;
+
+            // Items of the first run already smaller than the second run stay in place
+            int skipped = TimSortGallop(state.array[base2], state.array, base1, length1, true);
+            base1 += skipped;
+            length1 -= skipped;
+            if (length1 == 0)
+                return;
+
+            // Items of the second run bigger than the whole first run stay in place
+            length2 = TimSortGallop(state.array[base1 + length1 - 1], state.array, base2, length2, false);
+            if (length2 == 0)
+                return;
+
+            TimSortMergeRuns(state, base1, length1, base2, length2);
+        }
+
+        static void TimSortMergeCollapse(TimSortState& state)
+        {
+            int* length = state.runLength;
+
+            while (state.runCount > 1)
+            {
+                int n = state.runCount - 2;
+
+                if ((n > 0 && length[n - 1] <= length[n] + length[n + 1]) ||
+                    (n > 1 && length[n - 2] <= length[n - 1] + length[n]))
+                {
+                    if (length[n - 1] < length[n + 1])
+                        n--;
+                }
+                else if (length[n] > length[n + 1])
+                {
+                    break;
+                }
+
+                TimSortMergeAt(state, n);
+            }
+        }
+
+    public:
+        /**
+         * @brief Checks if the first item comes after the second one.
+         */
+        static bool IsBiggerThan(Item first, Item second)
+        {
+            STATS_COUNT(STATS_COMPARISONS);
+            return Less()(KeyOf()(second), KeyOf()(first));
+        }
+
+        /**
+         * @brief Checks if the first item comes strictly before the second one.
+         */
+        static bool IsLess(Item first, Item second)
+        {
+            return IsBiggerThan(second, first);
+        }
+
+        /**
+         * @brief Checks if the first item can stay before the second one.
+         */
+        static bool IsLessThanOrEqual(Item first, Item second)
+        {
+            return !IsBiggerThan(first, second);
+        }
+
+        /**
+         * @brief Sorts with BubbleSort, stopping after a pass without swaps.
+         *
+         * @param array The items.
+         * @param length The number of items.
+         */
+        static void BubbleSort(Item* array, int length)
+        {
+            for (int i = 0; i < length - 1; i++)
+            {
+                bool swapped = false;
+
+                for (int j = 0; j < length - i - 1; j++)
+                {
+                    if (IsBiggerThan(array[j], array[j + 1]))
+                    {
+                        Swap(array, j, j + 1);
+                        swapped = true;
+                    }
+                }
+
+                if (!swapped)
+                    break;
+            }
+        }
+
+        /**
+         * @brief Sorts with SelectionSort.
+         *
+         * @param array The items.
+         * @param length The number of items.
+         */
+        static void SelectionSort(Item* array, int length)
+        {
+            for (int i = 0; i < length - 1; i++)
+            {
+                int min = i;
+
+                for (int j = i; j < length; j++)
+                {
+                    if (IsLessThanOrEqual(array[j], array[min]))
+                        min = j;
+                }
+
+                Swap(array, i, min);
+            }
+        }
+
+        /**
+         * @brief Sorts with InsertionSort. Items equal to the inserted one are moved after it.
+         *
+         * @param array The items.
+         * @param length The number of items.
+         */
+        static void InsertionSort(Item* array, int length)
+        {
+            for (int i = 0; i < length; i++)
+            {
+                Item current = array[i];
+
+                int j = i - 1;
+                while (j >= 0 && IsLessThanOrEqual(current, array[j]))
+                {
+                    array[j + 1] = array[j];
+                    j--;
+                }
+                array[j + 1] = current;
+            }
+        }
+
+        /**
+         * @brief Sorts with QuickSort, using the first item of each range as the pivot.
+         *
+         * @param array The items.
+         * @param length The number of items.
+         */
+        static void QuickSort(Item* array, int length)
+        {
+            QuickSortRecursive(array, 0, length - 1);
+        }
+
+        /**
+         * @brief Sorts with a top-down MergeSort.
+         *
+         * @param array The items.
+         * @param length The number of items.
+         */
+        static void MergeSort(Item* array, int length)
+        {
+            if (length < 2)
+                return;
+
+            Item* buffer = new Item[length];
+            MergeSortRecursive(array, buffer, 0, length - 1);
+            delete[] buffer;
+        }
+
+        /**
+         * @brief Sorts with HeapSort.
+         *
+         * @param array The items.
+         * @param length The number of items.
+         */
+        static void HeapSort(Item* array, int length)
+        {
+            for (int i = length / 2 - 1; i >= 0; i--)
+                Heapify(array, length, i);
+
+            for (int i = length - 1; i >= 0; i--)
+            {
+                Swap(array, 0, i);
+                Heapify(array, i, 0);
+            }
+        }
+
+        /**
+         * @brief Applies CustomSort: each position, in order, receives the item that has as many smaller
+         * items as its index, swapping places with the one there. Positions are not visited again, so the
+         * result is only fully sorted when no swapped item still needed to move.
+         *
+         * @param array The items.
+         * @param length The number of items.
+         */
+        static void CustomSort(Item* array, int length)
+        {
+            for (int current = 0; current < length; current++)
+            {
+                int biggerThan = 0;
+                for (int i = 0; i < length; i++)
+                {
+                    if (IsBiggerThan(array[current], array[i]))
+                        biggerThan++;
+                }
+
+                if (current != biggerThan)
+                    Swap(array, current, biggerThan);
+            }
+        }
+
+        /**
+         * @brief Sorts with IntroSort (pattern-defeating quicksort), handling sorted and reversed inputs in O(n).
+         *
+         * @param array The items.
+         * @param length The number of items.
+         */
+        static void IntroSort(Item* array, int length)
+        {
+            if (length < 2)
+                return;
+
+            bool sorted = true;
+            bool reversed = true;
+            for (int i = 1; i < length && (sorted || reversed); i++)
+            {
+                if (IsLess(array[i], array[i - 1]))
+                    sorted = false;
+                else
+                    reversed = false;
+            }
+
+            if (sorted)
+                return;
+
+            if (reversed)
+            {
+                for (int i = 0, j = length - 1; i < j; i++, j--)
+                    Swap(array, i, j);
+            }
+            else
+            {
+                IntroSortLoop(array, 0, length, IntroSortDepthLimit(length));
+            }
+        }
+
+        /**
+         * @brief Sorts with TimSort (stable, adaptive to natural runs).
+         *
+         * @param array The items.
+         * @param length The number of items.
+         */
+        static void TimSort(Item* array, int length)
+        {
+            if (length < 2)
+                return;
+
+            TimSortState state;
+            state.array = array;
+            state.buffer = new Item[length];
+            state.minGallop = TIM_SORT_MIN_GALLOP;
+            state.runCount = 0;
+
+            int minRun = TimSortMinRunLength(length);
+
+            int begin = 0;
+            while (begin < length)
+            {
+                int runLength = TimSortCountRun(state.array, begin, length);
+
+                if (runLength < minRun)
+                {
+                    int forced = minRun < length - begin ? minRun : length - begin;
+                    BinaryInsertionSort(state.array, begin, begin + forced, begin + runLength);
+                    runLength = forced;
+                }
+
+                state.runBase[state.runCount] = begin;
+                state.runLength[state.runCount] = runLength;
+                state.runCount++;
+
+                TimSortMergeCollapse(state);
+                begin += runLength;
+            }
+
+            while (state.runCount > 1)
+            {
+                int n = state.runCount - 2;
+                if (n > 0 && state.runLength[n - 1] < state.runLength[n + 1])
+                    n--;
+
+                TimSortMergeAt(state, n);
+            }
+
+            delete[] state.buffer;
+        }
+
+        /**
+         * @brief Moves the smallest items to the beginning of the array, in order, without sorting the
+         * rest: a quickselect isolates them in O(n) and only they are sorted, resulting in O(n + k log k).
+         *
+         * @param array The items.
+         * @param length The number of items.
+         * @param count The number (k) of items desired, at most length.
+         */
+        static void SelectFirst(Item* array, int length, int count)
+        {
+            int depthLimit = IntroSortDepthLimit(length);
+
+            // Quickselect: narrows the range containing the position "count" until the
+            // smallest items are all before it
+            int begin = 0;
+            int end = length;
+            while (end - begin > INSERTION_SORT_THRESHOLD)
+            {
+                if (depthLimit-- == 0)
+                {
+                    HeapSortRange(array, begin, end);
+                    break;
+                }
+
+                IntroSortChoosePivot(array, begin, end);
+
+                bool alreadyPartitioned;
+                int pivotIndex = IntroSortPartition(array, begin, end, alreadyPartitioned);
+
+                if (pivotIndex == count)
+                    break;
+
+                if (pivotIndex > count)
+                    end = pivotIndex;
+                else
+                    begin = pivotIndex + 1;
+            }
+
+            if (end - begin <= INSERTION_SORT_THRESHOLD)
+                InsertionSortRange(array, begin, end);
+
+            IntroSortLoop(array, 0, count, IntroSortDepthLimit(count));
+        }
+};
+
+#endif
@@ -0,0 +1,107 @@
+#pragma once
+
+#ifndef OUTPUT_WRITER_HPP
+#define OUTPUT_WRITER_HPP
+
+#include <string>
+#include <cstddef>
+
+#define DEFAULT_OUTPUT_BUFFER_SIZE (1 << 16)
+
+/**
+ * @brief Exception thrown when the buffered output cannot be written to its file descriptor.
+ */
+class output_write_exception
+{};
+
+/**
+ * @brief Structure that writes text to a file descriptor through a reusable buffer. Numbers are
+ * formatted directly into the buffer (std::to_chars), without temporary strings, and the buffer
+ * is flushed with a single write call whenever it fills up, so the memory used does not depend
+ * on the size of the output.
+ */
+class OutputWriter
+{
+    private:
+        int _fileDescriptor;
+        std::string* _destination;
+        char* _buffer;
+        size_t _capacity;
+        size_t _length;
+
+        /**
+         * @brief Guarantees that the buffer has room for a number of bytes, flushing it if needed.
+         *
+         * @param bytes The number of bytes that will be written.
+         */
+        void Reserve(size_t bytes);
+
+    public:
+        /**
+         * @brief Constructor responsible for allocating the buffer.
+         *
+         * @param fileDescriptor The destination of the output.
+         * @param capacity The size of the buffer in bytes.
+         */
+        OutputWriter(int fileDescriptor, size_t capacity = DEFAULT_OUTPUT_BUFFER_SIZE);
+
+        /**
+         * @brief Constructor responsible for allocating the buffer, with the output kept in memory.
+         *
+         * @param destination The string that receives the output whenever the buffer is flushed.
+         * @param capacity The size of the buffer in bytes.
+         */
+        OutputWriter(std::string& destination, size_t capacity = DEFAULT_OUTPUT_BUFFER_SIZE);
+
+        /**
+         * @brief Destructor responsible for flushing the pending output and freeing the buffer.
+         * Errors are ignored here, call Flush to detect them.
+         */
+        ~OutputWriter();
+
+        /**
+         * @brief Writes an integer in decimal notation.
+         *
+         * @param value The number to be written.
+         */
+        void WriteInt(long long value);
+
+        /**
+         * @brief Writes a single character.
+         *
+         * @param character The character to be written.
+         */
+        void WriteChar(char character);
+
+        /**
+         * @brief Writes a sequence of bytes.
+         *
+         * @param data The bytes to be written.
+         * @param length The number of bytes.
+         */
+        void WriteBytes(const char* data, size_t length);
+
+        /**
+         * @brief Sends the buffered output to the file descriptor (or appends it to the string).
+         *
+         * @throw output_write_exception If the output could not be written.
+         */
+        void Flush();
+
+        /**
+         * @brief Changes the destination of the output, flushing what was written so far. Allows
+         * the same buffer to be reused for several outputs.
+         *
+         * @param fileDescriptor The new destination.
+         */
+        void Redirect(int fileDescriptor);
+
+        /**
+         * @brief Changes the destination of the output to a string, flushing what was written so far.
+         *
+         * @param destination The string that receives the output.
+         */
+        void Redirect(std::string& destination);
+};
+
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+
+#ifndef PACKED_KEY_SORTER_HPP
+#define PACKED_KEY_SORTER_HPP
+
+#include "Vertex.hpp"
+
+/**
+ * @brief Structure responsible for sorting vertices through 64-bit packed keys in the format
+ * (color << 32) | id. Comparing two keys is then equivalent to Vertex::IsBiggerThan, but can be
+ * done with a single instruction, which allows the use of SIMD (AVX2) sorting networks and partitions.
+ * The AVX2 implementation is only used when the processor supports it, detected at runtime.
+ */
+class PackedKeySorter
+{
+    public:
+        /**
+         * @brief Builds the packed key of a vertex.
+         *
+         * @param vertex The vertex to be packed. Its id must not be negative.
+         * @return The key (color << 32) | id.
+         */
+        static long long Pack(Vertex* vertex);
+
+        /**
+         * @brief Extracts the vertex id from a packed key.
+         *
+         * @param key The packed key.
+         * @return The id stored in the key.
+         */
+        static int UnpackId(long long key);
+
+        /**
+         * @brief Checks if the current processor supports the AVX2 instruction set.
+         *
+         * @return true if AVX2 is available, false otherwise.
+         */
+        static bool HasAvx2();
+
+        /**
+         * @brief Sorts the keys in ascending order, choosing the AVX2 implementation when available
+         * and the scalar one otherwise.
+         *
+         * @param keys The keys to be sorted.
+         * @param length The number of keys.
+         */
+        static void Sort(long long* keys, int length);
+
+        /**
+         * @brief Sorts the keys in ascending order without SIMD instructions.
+         *
+         * @param keys The keys to be sorted.
+         * @param length The number of keys.
+         */
+        static void SortScalar(long long* keys, int length);
+
+        /**
+         * @brief Sorts the keys in ascending order with an AVX2 quicksort (vectorized partition and
+         * sorting networks for blocks of up to 16 keys). Must only be called if HasAvx2() is true.
+         *
+         * @param keys The keys to be sorted.
+         * @param length The number of keys.
+         */
+        static void SortAvx2(long long* keys, int length);
+};
+
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#define PERF_UNAVAILABLE (-1)
+
+/**
+ * @brief Hardware events measured by PerfCounters.
+ */
+enum PerfEvent
+{
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_EVENT_COUNT
+};
+
+/**
+ * @brief Hardware performance counters of the calling thread, read through the Linux perf_event_open
+ * interface (user space only). Each event is opened on its own, so the ones the processor, the kernel
+ * or its permissions (perf_event_paranoid) do not allow are simply reported as PERF_UNAVAILABLE while
+ * the others keep working. When the kernel multiplexes the counters, the values are scaled by the time
+ * each one was actually running.
+ */
+class PerfCounters
+{
+    private:
+        int _fileDescriptors[PERF_EVENT_COUNT];
+
+    public:
+        /**
+         * @brief Constructor responsible for opening the counters for the calling thread.
+         */
+        PerfCounters();
+
+        /**
+         * @brief Destructor responsible for closing the counters.
+         */
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        /**
+         * @brief Checks if at least one counter could be opened.
+         *
+         * @return true if some counter is available, false otherwise.
+         */
+        bool IsAvailable();
+
+        /**
+         * @brief Reads the current value of every counter.
+         *
+         * @param values Array with PERF_EVENT_COUNT positions that receives the values, or PERF_UNAVAILABLE.
+         */
+        void Read(long long* values);
+
+        /**
+         * @brief Returns the name of an event, as shown in the reports.
+         *
+         * @param event The event.
+         * @return The name.
+         */
+        static const char* EventName(PerfEvent event);
+};
+
+#endif
@@ -0,0 +1,204 @@
+#pragma once
+
+#ifndef PROGRAM_OPTIONS_HPP
+#define PROGRAM_OPTIONS_HPP
+
+#include <cstddef>
+
+#include "VertexRelabeler.hpp"
+
+#define ALL_VERTICES (-1)
+#define DEFAULT_MEMORY_BUDGET (0)
+
+/**
+ * @brief Exception thrown when the command line has an unknown option or an invalid value.
+ */
+class invalid_program_argument_exception
+{};
+
+/**
+ * @brief Structure representing the options received by the program through the command line.
+ */
+class ProgramOptions
+{
+    private:
+        int _firstCount;
+        bool _verbose;
+        size_t _memoryBudget;
+        bool _binary;
+        const char* _outputPath;
+        const char* _socketPath;
+        const char* _batchPattern;
+        bool _pipeline;
+        bool _colorings;
+        const char* _streamPath;
+        bool _stats;
+        const char* _statsTracePath;
+        bool _perf;
+        RelabelOrder _relabelOrder;
+        int _workerCount;
+        int _processCount;
+        bool _numa;
+
+    public:
+        /**
+         * @brief Default constructor, with every option in its default value.
+         */
+        ProgramOptions();
+
+        /**
+         * @brief Builds the options from the arguments received by the program. Accepted options:
+         *
+         *   -k, --first <count>   Prints only the first <count> ordered vertices.
+         *   -v, --verbose         Reports on the standard error the method chosen by the automatic orderer.
+         *   -m, --memory <bytes>  Memory budget of the external orderer ('e'), accepts the suffixes K, M and G.
+         *   -b, --binary          Writes the answer as a binary permutation (see BinaryPermutation).
+         *   -o, --output <path>   Writes the answer to a file instead of the standard output
+         *                         (memory mapped in the binary mode).
+         *   -S, --serve <path>    Runs as a server on the Unix domain socket <path> (see GraphServer).
+         *   -B, --batch <pattern> Verifies every file of a directory, or matched by a glob pattern (see BatchRunner).
+         *   -P, --pipeline        Reads graphs until the end of the input, answering each one (see GraphPipeline).
+         *   -C, --colorings       Reads one graph followed by many color lines, answering each coloring
+         *                         (see MultiColoringVerifier).
+         *   -s, --stream <path>   Verifies the graph of a file in two passes, without building it
+         *                         (see StreamingVerifier); "-" reads the standard input, which must be a file.
+         *   --stats               Reports the time of each phase and the operation counters on the standard error.
+         *   --stats-trace <path>  Writes the phases and counters as a Chrome trace (JSON) file.
+         *   --perf                Adds the hardware counters (cycles, instructions, cache and branch misses)
+         *                         to the statistics, implying --stats.
+         *   -w, --workers <count> Number of worker threads of the server or batch (default: number of cores).
+         *   -r, --relabel <order> Rebuilds the vertices in a locality order before the verification:
+         *                         none (default), degree, bfs or rcm (see VertexRelabeler).
+         *   -p, --processes <count> Verifies the graph with <count> processes over shared memory
+         *                         (see ShardedVerifier), 0 (default) to verify it in the program itself.
+         *   --numa                Pins each verification process to a NUMA node.
+         *
+         * @param argc The number of arguments.
+         * @param argv The arguments, where argv[0] is the program name.
+         * @return The options read.
+         * @throw invalid_program_argument_exception If an option is unknown or has an invalid value.
+         */
+        static ProgramOptions Parse(int argc, char const *argv[]);
+
+        /**
+         * @brief Returns how many ordered vertices must be printed.
+         *
+         * @return The number of vertices, or ALL_VERTICES.
+         */
+        int GetFirstCount();
+
+        /**
+         * @brief Checks if details about the execution must be reported on the standard error.
+         *
+         * @return true if verbose, false otherwise.
+         */
+        bool IsVerbose();
+
+        /**
+         * @brief Returns the memory budget requested for the external orderer.
+         *
+         * @return The budget in bytes, or DEFAULT_MEMORY_BUDGET if none was given.
+         */
+        size_t GetMemoryBudget();
+
+        /**
+         * @brief Checks if the answer must be written in the binary format.
+         *
+         * @return true if binary, false if text.
+         */
+        bool IsBinary();
+
+        /**
+         * @brief Returns the file that must receive the answer.
+         *
+         * @return The path of the file, or nullptr for the standard output.
+         */
+        const char* GetOutputPath();
+
+        /**
+         * @brief Returns the socket on which the program must run as a server.
+         *
+         * @return The path of the socket, or nullptr if the program must not run as a server.
+         */
+        const char* GetSocketPath();
+
+        /**
+         * @brief Returns the directory or glob pattern of the files that must be verified in batch.
+         *
+         * @return The pattern, or nullptr if the program must read a single graph from the standard input.
+         */
+        const char* GetBatchPattern();
+
+        /**
+         * @brief Checks if a sequence of graphs must be read from the standard input by the pipeline.
+         *
+         * @return true if the pipeline must be used, false if a single graph must be read.
+         */
+        bool IsPipeline();
+
+        /**
+         * @brief Checks if the graph of the standard input is followed by many colorings, each one answered.
+         *
+         * @return true if many colorings must be read, false if the graph has a single one.
+         */
+        bool IsColorings();
+
+        /**
+         * @brief Returns the file whose graph must be verified in two passes without being built.
+         *
+         * @return The path, or nullptr if the graph must be built.
+         */
+        const char* GetStreamPath();
+
+        /**
+         * @brief Checks if the statistics of the execution must be reported on the standard error.
+         * They are only collected when the program is compiled with GRAPH_STATS.
+         *
+         * @return true if they must be reported, false otherwise.
+         */
+        bool IsStats();
+
+        /**
+         * @brief Returns the file that must receive the statistics as a Chrome trace.
+         *
+         * @return The path of the file, or nullptr if no trace was requested.
+         */
+        const char* GetStatsTracePath();
+
+        /**
+         * @brief Checks if the statistics must include the hardware performance counters.
+         *
+         * @return true if they must be included, false otherwise.
+         */
+        bool IsPerf();
+
+        /**
+         * @brief Returns the order in which the vertices must be rebuilt before the verification.
+         *
+         * @return The order, or RELABEL_NONE.
+         */
+        RelabelOrder GetRelabelOrder();
+
+        /**
+         * @brief Returns the number of worker threads requested.
+         *
+         * @return The number of workers.
+         */
+        int GetWorkerCount();
+
+        /**
+         * @brief Returns the number of processes that must verify the graph.
+         *
+         * @return The number of processes, or 0 if the graph must be verified by the program itself.
+         */
+        int GetProcessCount();
+
+        /**
+         * @brief Checks if the verification processes must be pinned to NUMA nodes.
+         *
+         * @return true if they must be pinned, false otherwise.
+         */
+        bool IsNuma();
+};
+
+#endif
@@ -0,0 +1,90 @@
+#pragma once
+
+#ifndef SHARDED_VERIFIER_HPP
+#define SHARDED_VERIFIER_HPP
+
+#include <vector>
+
+#include "SharedGraph.hpp"
+
+#define STOP_CHECK_INTERVAL (1024)
+
+/**
+ * @brief Exception thrown when a worker process cannot be created or ends without a verdict.
+ */
+class worker_process_exception
+{};
+
+/**
+ * @brief Structure that verifies if a graph in shared memory is greedy with several processes, each
+ * responsible for a shard of consecutive vertices with about the same number of adjacencies.
+ *
+ * The workers are forked after the graph is in the segment, so they read it without any copy. The first
+ * worker that finds a vertex that is not greedy raises the stop flag of the segment, and the others check
+ * it every STOP_CHECK_INTERVAL vertices and quit without finishing their shards. The coordinator (the
+ * calling process) waits for every worker and merges their verdicts from the exit statuses.
+ *
+ * Optionally, worker i is pinned to the processors of NUMA node i modulo the number of nodes, read from
+ * /sys/devices/system/node, so the workers spread over the memory controllers of the machine.
+ */
+class ShardedVerifier
+{
+    private:
+        SharedGraph& _graph;
+        int _processCount;
+        bool _pinNuma;
+        int _stoppedCount;
+        int _pinnedCount;
+
+        /**
+         * @brief Verifies a shard and finishes the worker process with its verdict. Never returns.
+         *
+         * @param start The position of the first vertex of the shard.
+         * @param end The position after the last vertex of the shard.
+         * @param node The processors the worker must be pinned to, or an empty list to keep its affinity.
+         * @param seen Scratch array of SharedGraph::IsGreedyVertex, large enough for any vertex.
+         */
+        [[noreturn]] void WorkerMain(int start, int end, const std::vector<int>& node, std::vector<int>& seen);
+
+    public:
+        /**
+         * @brief Constructor responsible for keeping the parameters of the verification.
+         *
+         * @param graph The graph in shared memory.
+         * @param processCount The number of worker processes.
+         * @param pinNuma If each worker is pinned to a NUMA node.
+         */
+        ShardedVerifier(SharedGraph& graph, int processCount, bool pinNuma = false);
+
+        /**
+         * @brief Forks the workers, waits for all of them and merges their verdicts. The workers do not
+         * allocate memory, so other threads of the process cannot leave them blocked on a lock of the allocator.
+         *
+         * @return true if every vertex is greedy, false otherwise.
+         * @throw worker_process_exception If a worker cannot be created or ends without a verdict.
+         */
+        bool Run();
+
+        /**
+         * @brief Counts the workers of the last run that quit before finishing their shards.
+         *
+         * @return The number of workers.
+         */
+        int StoppedCount();
+
+        /**
+         * @brief Counts the workers of the last run that were pinned to a NUMA node.
+         *
+         * @return The number of workers.
+         */
+        int PinnedCount();
+
+        /**
+         * @brief Reads the processors of each NUMA node of the machine.
+         *
+         * @return The processors of each node, or an empty list if the system does not describe its nodes.
+         */
+        static std::vector<std::vector<int>> NumaNodes();
+};
+
+#endif
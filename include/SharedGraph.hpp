@@ -0,0 +1,138 @@
+#pragma once
+
+#ifndef SHARED_GRAPH_HPP
+#define SHARED_GRAPH_HPP
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Graph.hpp"
+
+/**
+ * @brief Exception thrown when the shared memory segment cannot be created or mapped.
+ */
+class shared_memory_exception
+{};
+
+/**
+ * @brief Header at the beginning of the shared memory segment.
+ */
+struct SharedGraphHeader
+{
+    int64_t vertexCount;
+    int64_t adjacencyCount;
+    int64_t maxDegree;
+    std::atomic<int> stop;
+    std::atomic<int> failedPosition;
+};
+
+/**
+ * @brief Structure that copies a graph to an anonymous POSIX shared memory segment, so processes forked
+ * afterwards read the same ids, colors and adjacencies without copying them.
+ *
+ * The segment holds a header, the ids and colors of the vertices in the order of the graph, and the
+ * adjacencies as compressed rows of positions (offsets and neighbors). Its name is removed right after
+ * it is mapped, so the memory is released when the last process unmaps it, even after a crash. The
+ * header also has a flag that any process can raise to ask the others to stop, and the first vertex
+ * found not to be greedy.
+ */
+class SharedGraph
+{
+    private:
+        void* _memory;
+        size_t _size;
+
+        SharedGraphHeader* _header;
+        int* _ids;
+        int* _colors;
+        int64_t* _offsets;
+        int* _neighbors;
+
+    public:
+        /**
+         * @brief Constructor responsible for creating the segment and copying the graph to it.
+         *
+         * @param graph The graph.
+         * @throw shared_memory_exception If the segment cannot be created or mapped.
+         */
+        SharedGraph(Graph* graph);
+
+        /**
+         * @brief Destructor responsible for unmapping the segment in the calling process.
+         */
+        ~SharedGraph();
+
+        SharedGraph(const SharedGraph&) = delete;
+        SharedGraph& operator=(const SharedGraph&) = delete;
+
+        /**
+         * @brief Checks if a vertex is greedy, with the same rules as Vertex::IsGreedy: color 1 is always
+         * greedy, and any other color needs a neighbor of each smaller color.
+         *
+         * @param position The position of the vertex.
+         * @param seen Scratch array, reused between calls, where seen[c] records the last vertex that had a neighbor of color c.
+         * @return true if greedy, false otherwise.
+         */
+        bool IsGreedyVertex(int position, std::vector<int>& seen);
+
+        /**
+         * @brief Returns the position where each shard of vertices starts, so each shard has about the
+         * same number of vertices plus adjacencies.
+         *
+         * @param shardCount The number of shards.
+         * @return shardCount + 1 positions, the last one being the number of vertices.
+         */
+        std::vector<int> SplitShards(int shardCount);
+
+        /**
+         * @brief Records a vertex that is not greedy, if none was recorded before, and asks every process to stop.
+         *
+         * @param position The position of the vertex.
+         */
+        void RecordFailure(int position);
+
+        /**
+         * @brief Forgets the recorded failure and lowers the stop flag, before a new verification.
+         */
+        void ResetFailure();
+
+        /**
+         * @brief Returns the id of the first vertex recorded as not greedy.
+         *
+         * @return The id, or -1 if no failure was recorded.
+         */
+        int FailedId();
+
+        /**
+         * @brief Returns the flag that asks the processes to stop, shared by all of them.
+         *
+         * @return The flag, nonzero when the processes must stop.
+         */
+        std::atomic<int>& StopFlag();
+
+        /**
+         * @brief Counts the vertices of the graph.
+         *
+         * @return The number of vertices.
+         */
+        int VertexCount();
+
+        /**
+         * @brief Returns the largest number of adjacencies of a vertex. Since a greedy vertex has at most
+         * that many colors below its own, it bounds the scratch array of IsGreedyVertex.
+         *
+         * @return The largest degree.
+         */
+        int64_t MaxDegree();
+
+        /**
+         * @brief Returns the size of the segment.
+         *
+         * @return The size in bytes.
+         */
+        size_t Size();
+};
+
+#endif
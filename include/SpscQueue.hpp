@@ -0,0 +1,121 @@
+#pragma once
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+
+#define CACHE_LINE_SIZE (64)
+
+/**
+ * @file SpscQueue.hpp
+ * @brief Class representing a bounded lock-free queue with a single producer and a single consumer.
+ *
+ * The elements are kept in a ring whose capacity is rounded up to a power of two. The producer only
+ * writes the tail index and the consumer only writes the head index, so each side needs just an
+ * acquire load of the other index and a release store of its own. Both indexes live in separate
+ * cache lines to avoid false sharing between the two threads. The queue never blocks: TryPush fails
+ * when it is full (which is how backpressure reaches the producer) and TryPop fails when it is empty.
+ *
+ * @tparam DataType The data type of the elements in the queue.
+ */
+template <class DataType>
+class SpscQueue
+{
+    private:
+        DataType* _items;
+        size_t _mask;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail;
+
+    public:
+        /**
+         * @brief Constructor responsible for allocating the ring.
+         *
+         * @param capacity The minimum number of elements the queue must hold.
+         */
+        SpscQueue(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity)
+                size <<= 1;
+
+            _items = new DataType[size];
+            _mask = size - 1;
+            _head = 0;
+            _tail = 0;
+        }
+
+        /**
+         * @brief Destructor responsible for freeing the ring. The elements still queued are discarded.
+         */
+        ~SpscQueue()
+        {
+            delete[] _items;
+        }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        /**
+         * @brief Adds an element to the end of the queue. Must only be called by the producer.
+         *
+         * @param item The element to be added.
+         * @return true if the element was added, false if the queue is full.
+         */
+        bool TryPush(const DataType& item)
+        {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+
+            if (tail - _head.load(std::memory_order_acquire) > _mask)
+                return false;
+
+            _items[tail & _mask] = item;
+            _tail.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @brief Removes the element at the front of the queue. Must only be called by the consumer.
+         *
+         * @param item Receives the element removed.
+         * @return true if an element was removed, false if the queue is empty.
+         */
+        bool TryPop(DataType& item)
+        {
+            size_t head = _head.load(std::memory_order_relaxed);
+
+            if (head == _tail.load(std::memory_order_acquire))
+                return false;
+
+            item = _items[head & _mask];
+            _head.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @brief Checks if the queue is empty. Exact only when called by the consumer.
+         *
+         * @return true if empty, false otherwise.
+         */
+        bool Empty()
+        {
+            return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Returns the number of elements the queue can hold.
+         *
+         * @return The capacity.
+         */
+        size_t Capacity()
+        {
+            return _mask + 1;
+        }
+};
+
+#endif
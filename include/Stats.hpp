@@ -0,0 +1,183 @@
+#pragma once
+
+#ifndef STATS_HPP
+#define STATS_HPP
+
+/**
+ * @file Stats.hpp
+ * @brief Optional instrumentation: wall time per phase and operation counters.
+ *
+ * Everything here only exists when the program is compiled with GRAPH_STATS (make STATS=1).
+ * Otherwise the macros below expand to nothing, so the instrumented code has no cost at all.
+ *
+ * STATS_ADD(counter, amount) and STATS_COUNT(counter) update a counter of the current thread.
+ * STATS_PHASE(name) measures the rest of the enclosing scope as a phase, recording its duration and
+ * how much each counter of the thread changed meanwhile. After EnableHardwareCounters, the phases also
+ * record the hardware events of the thread (see PerfCounters).
+ */
+
+#ifdef GRAPH_STATS
+
+#include <chrono>
+#include <string>
+#include <ostream>
+
+#include "PerfCounters.hpp"
+
+/**
+ * @brief Counters of the operations performed by the program.
+ */
+enum StatsCounter
+{
+    STATS_COMPARISONS,
+    STATS_SWAPS,
+    STATS_CURSOR_HITS,
+    STATS_LINEAR_WALKS,
+    STATS_WALK_LENGTH,
+    STATS_ALLOCATIONS,
+    STATS_VERTICES_READ,
+    STATS_EDGES_READ,
+    STATS_COUNTER_COUNT
+};
+
+/**
+ * @brief Structure that keeps the counters of each thread and the phases recorded by all of them.
+ */
+class Stats
+{
+    private:
+        inline static thread_local long long _counters[STATS_COUNTER_COUNT] = {};
+        inline static bool _hardwareCounters = false;
+
+    public:
+        /**
+         * @brief Adds an amount to a counter of the current thread.
+         *
+         * @param counter The counter.
+         * @param amount The amount to be added.
+         */
+        static void Add(StatsCounter counter, long long amount)
+        {
+            _counters[counter] += amount;
+        }
+
+        /**
+         * @brief Returns the value of a counter of the current thread.
+         *
+         * @param counter The counter.
+         * @return The value of the counter.
+         */
+        static long long Get(StatsCounter counter)
+        {
+            return _counters[counter];
+        }
+
+        /**
+         * @brief Returns the name of a counter, as shown in the reports.
+         *
+         * @param counter The counter.
+         * @return The name.
+         */
+        static const char* CounterName(StatsCounter counter);
+
+        /**
+         * @brief Makes the next phases also measure the hardware events. Must be called before any thread
+         * other than the calling one starts a phase.
+         *
+         * @return true if at least one hardware counter is available, false if they will all be reported as unavailable.
+         */
+        static bool EnableHardwareCounters();
+
+        /**
+         * @brief Checks if the phases measure the hardware events.
+         *
+         * @return true if enabled, false otherwise.
+         */
+        static bool HasHardwareCounters()
+        {
+            return _hardwareCounters;
+        }
+
+        /**
+         * @brief Reads the hardware counters of the current thread.
+         *
+         * @param values Array with PERF_EVENT_COUNT positions that receives the values.
+         */
+        static void ReadHardwareCounters(long long* values);
+
+        /**
+         * @brief Records a finished phase.
+         *
+         * @param name The name of the phase.
+         * @param start When the phase started.
+         * @param end When the phase ended.
+         * @param deltas How much each counter changed during the phase.
+         * @param events How much each hardware event changed during the phase, or PERF_UNAVAILABLE.
+         */
+        static void RecordPhase(const std::string& name, std::chrono::steady_clock::time_point start,
+                                std::chrono::steady_clock::time_point end, const long long* deltas, const long long* events);
+
+        /**
+         * @brief Writes a table with the phases grouped by name: how many times each one ran, its total
+         * time and the sum of its counters. With the hardware counters enabled, a second table shows the
+         * events of each phase, the instructions per cycle and the misses per vertex and per edge read.
+         *
+         * @param output The destination of the table.
+         */
+        static void WriteReport(std::ostream& output);
+
+        /**
+         * @brief Writes every phase recorded as a Chrome trace (JSON loaded by chrome://tracing or Perfetto),
+         * with the counters as the arguments of each event.
+         *
+         * @param output The destination of the trace.
+         */
+        static void WriteTrace(std::ostream& output);
+
+        /**
+         * @brief Discards the phases recorded so far.
+         */
+        static void Clear();
+};
+
+/**
+ * @brief Measures a phase from its construction to its destruction.
+ */
+class StatsPhase
+{
+    private:
+        std::string _name;
+        std::chrono::steady_clock::time_point _start;
+        long long _counters[STATS_COUNTER_COUNT];
+        long long _events[PERF_EVENT_COUNT];
+
+    public:
+        /**
+         * @brief Constructor responsible for starting the phase.
+         *
+         * @param name The name of the phase.
+         */
+        StatsPhase(std::string name);
+
+        /**
+         * @brief Destructor responsible for recording the phase.
+         */
+        ~StatsPhase();
+};
+
+#define STATS_CONCAT_INNER(first, second) first##second
+#define STATS_CONCAT(first, second) STATS_CONCAT_INNER(first, second)
+
+#define STATS_ADD(counter, amount) Stats::Add(counter, amount)
+#define STATS_PHASE(name) StatsPhase STATS_CONCAT(statsPhase, __LINE__)(name)
+
+#else
+
+#define STATS_ADD(counter, amount) ((void)0)
+#define STATS_PHASE(name) ((void)0)
+
+#endif
+
+#define STATS_COUNT(counter) STATS_ADD(counter, 1)
+
+#endif
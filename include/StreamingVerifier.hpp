@@ -0,0 +1,108 @@
+#pragma once
+
+#ifndef STREAMING_VERIFIER_HPP
+#define STREAMING_VERIFIER_HPP
+
+#include <vector>
+#include <istream>
+
+#include "Graph.hpp"
+#include "OutputWriter.hpp"
+#include "MonotonicArena.hpp"
+
+/**
+ * @brief Exception thrown when the stream of the streaming verifier cannot be read a second time.
+ */
+class unseekable_input_exception
+{};
+
+/**
+ * @brief Verifies a graph from a seekable stream without building it, in two passes over the input.
+ * The first pass skips the adjacency lines and reads the colors at the end; the second one reads the
+ * adjacency lines again and checks each vertex as its line passes, so only the colors are kept in
+ * memory (O(V)) and the adjacency lists are never stored.
+ *
+ * The stream is read with the same operations as Graph::BuildFromIoStream, so the answer is the same
+ * as building the graph and verifying it with Graph::IsGreedy, and so are the errors and the order in
+ * which they are found: invalid ids while reading the adjacencies, then the color errors of
+ * SetVertexColor in vertex order, then an incomplete input.
+ */
+class StreamingVerifier
+{
+    private:
+        std::istream& _input;
+        char _sortMethod;
+        int _vertexCount;
+        std::streampos _adjacencyStart;
+        std::vector<int> _colors;
+
+        /**
+         * @brief Reads the adjacency lines, calling a function for the neighbors of each vertex. After the
+         * stream fails, every remaining read keeps the last value, so each vertex gets that neighbor once.
+         *
+         * @param visit Called with the position of the vertex and the id of each neighbor read for it.
+         * @param finish Called with the position of the vertex after its line.
+         */
+        template <typename Visit, typename Finish>
+        void ReadAdjacency(Visit visit, Finish finish);
+
+        /**
+         * @brief First pass: reads the sort method and the vertex count, checks the ids of the adjacency
+         * lines without storing them and reads the colors.
+         *
+         * @return true if the stream failed before the end of the colors.
+         * @throw unseekable_input_exception If the stream cannot tell its position.
+         * @throw invalid_orderer_option_exception If the sort method is invalid.
+         * @throw element_not_found_exception If a neighbor id is not a vertex.
+         */
+        bool ReadColors();
+
+        /**
+         * @brief Second pass: reads the adjacency lines again and checks each vertex.
+         *
+         * @return true if every vertex is greedy, false otherwise.
+         * @throw invalid_color_change_exception If a vertex has a negative color.
+         * @throw unavailable_color_exception If a vertex has the color of a neighbor that comes before it.
+         */
+        bool CheckVertices();
+
+    public:
+        /**
+         * @brief Constructor of a verifier for a stream.
+         *
+         * @param input The stream with the graph data, which must support seekg and tellg.
+         */
+        StreamingVerifier(std::istream& input);
+
+        /**
+         * @brief Verifies the graph of the stream.
+         *
+         * @return true if the coloring is greedy, false otherwise.
+         * @throw malformed_input_exception If the stream ended or had invalid data before the graph was complete.
+         * @throw invalid_orderer_option_exception, element_not_found_exception, invalid_color_change_exception,
+         * unavailable_color_exception The same errors as building the graph.
+         */
+        bool Verify();
+
+        /**
+         * @brief Builds a graph with the vertices and colors read, but no edges, which is all its orderer
+         * needs to sort the vertices with the sort method of the input.
+         *
+         * @param arena Arena used by the new graph, or nullptr to allocate each of its parts with new.
+         * @return A pointer to the new graph, which must be deleted by the caller.
+         */
+        Graph* BuildOrderingGraph(MonotonicArena* arena = nullptr);
+
+        /**
+         * @brief Verifies the graph of a stream and writes its answer: the same line written by
+         * GraphRunner::Run for the same input.
+         *
+         * @param input The stream with the graph data, which must support seekg and tellg.
+         * @param output The destination of the answer.
+         * @param firstCount How many of the first ordered vertices to write, or a negative number for all of them.
+         * @return true if the graph was processed, false if an error was described instead.
+         */
+        static bool Run(std::istream& input, OutputWriter& output, int firstCount = -1);
+};
+
+#endif
@@ -3,7 +3,11 @@
 #ifndef VERTEX_HPP
 #define VERTEX_HPP
 
+#include <vector>
+
 #include "LinkedList.hpp"
+#include "AdjacencyIndex.hpp"
+#include "MonotonicArena.hpp"
 
 #define UNDEFINED_COLOR (-1)
 
@@ -30,19 +34,24 @@ class Vertex
         int _id;
         int _color;
         LinkedList<Vertex*>* _adjacentVertices;
+        AdjacencyIndex _adjacencyIndex;
 
     public:
         /**
          * @brief Default constructor for the Vertex class.
          *
          * Creates a new vertex with default data and an id.
+         *
+         * @param id The identifier of the vertex.
+         * @param arena Arena where the adjacency list is allocated, or nullptr to allocate it with new.
          */
-        Vertex(int id);
+        Vertex(int id, MonotonicArena* arena = nullptr);
 
         /**
          * @brief Destructor for the Vertex class.
          *
-         * Responsible for freeing the memory allocated for this vertex.
+         * Responsible for freeing the memory allocated for this vertex. Vertices created with an arena
+         * belong to it and are never destroyed individually.
          */
         ~Vertex();
 
@@ -60,6 +69,13 @@ class Vertex
          */
         void SetColor(int color);
 
+        /**
+         * @brief Replaces the color of this vertex without the checks of SetColor.
+         *
+         * @param color The new color.
+         */
+        void ReplaceColor(int color);
+
         /**
          * @brief Returns the color of the vertex.
          *
@@ -73,9 +89,35 @@ class Vertex
          * @param vertex The destination vertex of the edge.
          */
         void AddAdjacentVertex(Vertex* vertex);
+
+        /**
+         * @brief Adds an edge without checking if it already exists, for callers whose adjacencies have
+         * no repeated neighbors.
+         *
+         * @param vertex The destination vertex of the edge, not adjacent to this one yet.
+         */
+        void AppendAdjacentVertex(Vertex* vertex);
+
+        /**
+         * @brief Prepares the adjacency index for the expected degree of this vertex: a bitset row if the
+         * degree reaches AdjacencyIndex::BitsetThreshold, otherwise room for that many neighbors.
+         *
+         * @param degree The expected number of adjacent vertices.
+         * @param vertexCount The number of vertices of the graph, whose ids are in [0, vertexCount).
+         */
+        void ReserveAdjacency(int degree, int vertexCount);
+
+        /**
+         * @brief Checks if the adjacency index of this vertex has a bitset row.
+         *
+         * @return true if it has, false otherwise.
+         */
+        bool HasDenseAdjacency();
         
         /**
-         * @brief Checks if a second vertex is adjacent to this one.
+         * @brief Checks if a second vertex is adjacent to this one. The vertices of a graph have distinct
+         * ids, so the check looks up the id in the adjacency index, in O(1) for vertices with a bitset row
+         * and O(log d) for the others.
          *
          * @param vertex A pointer to the vertex for checking.
          * 
@@ -107,6 +149,15 @@ class Vertex
          */
         bool IsGreedy();
 
+        /**
+         * @brief Same as IsGreedy(), reusing a scratch array between calls instead of allocating one.
+         *
+         * @param seen Scratch array where seen[c] records the last stamp that found a neighbor of color c.
+         * @param stamp A value different for each call with the same array.
+         * @return true if greedy, false otherwise.
+         */
+        bool IsGreedy(std::vector<int>& seen, int stamp);
+
         /**
          * @brief Compares two vertices, initially based on color and uses the identifier as a tiebreaker.
          * 
@@ -143,4 +194,14 @@ class Vertex
         bool IsLessThanOrEqual(Vertex* other);
 };
 
+inline int Vertex::GetId()
+{
+    return _id;
+}
+
+inline int Vertex::GetColor()
+{
+    return _color;
+}
+
 #endif
\ No newline at end of file
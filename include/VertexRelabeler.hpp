@@ -0,0 +1,122 @@
+#pragma once
+
+#ifndef VERTEX_RELABELER_HPP
+#define VERTEX_RELABELER_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Vertex.hpp"
+#include "LinkedList.hpp"
+#include "MonotonicArena.hpp"
+
+/**
+ * @brief Exception thrown when a relabeling order is unknown.
+ */
+class invalid_relabel_order_exception
+{};
+
+/**
+ * @brief Orders in which the vertices of a graph can be laid out in memory.
+ */
+enum RelabelOrder
+{
+    RELABEL_NONE,
+    RELABEL_DEGREE,
+    RELABEL_BFS,
+    RELABEL_RCM
+};
+
+/**
+ * @brief Structure that computes a new layout for the vertices of a graph, placing adjacent vertices
+ * close to each other, and rebuilds the vertices in that layout.
+ *
+ * The ids come from the input and the vertices are stored in the order of their ids, so the neighbors of
+ * a vertex are usually spread over the whole graph and each adjacency scan of the verification touches a
+ * different cache line per neighbor. The rebuilt vertices are allocated together in the new order, followed
+ * by their adjacency lists in the same order, while keeping their ids, so every answer stays in the original ids.
+ *
+ * The relabeler takes a snapshot of the adjacencies as positions in the vertex list (compressed rows),
+ * which is the only structure the orders are computed on.
+ */
+class VertexRelabeler
+{
+    private:
+        std::vector<Vertex*> _vertices;
+        std::vector<int64_t> _offsets;
+        std::vector<int> _neighbors;
+
+        /**
+         * @brief Visits the vertices in breadth first order, one component at a time, starting each
+         * component from the first vertex not yet visited in a sequence of candidates.
+         *
+         * @param starts The candidates to start a component, in order of preference.
+         * @param byDegree If the neighbors of each vertex are visited in increasing order of degree.
+         * @return The positions in the order they were visited.
+         */
+        std::vector<int> BreadthFirstOrder(const std::vector<int>& starts, bool byDegree);
+
+        /**
+         * @brief Returns the positions sorted by degree, keeping the current order among equal degrees.
+         *
+         * @param descending If the highest degrees come first.
+         * @return The sorted positions.
+         */
+        std::vector<int> DegreeOrder(bool descending);
+
+    public:
+        /**
+         * @brief Constructor responsible for taking the snapshot of the adjacencies.
+         *
+         * @param vertices The vertices, in their current order.
+         */
+        VertexRelabeler(LinkedList<Vertex*>* vertices);
+
+        /**
+         * @brief Computes a new order for the vertices.
+         *
+         * @param order The relabeling order: RELABEL_DEGREE (highest degrees first), RELABEL_BFS (breadth first
+         * search), RELABEL_RCM (reverse Cuthill–McKee) or RELABEL_NONE (the current order).
+         * @return The current positions of the vertices, in the new order.
+         */
+        std::vector<int> ComputeOrder(RelabelOrder order);
+
+        /**
+         * @brief Measures the bandwidth of an order: the largest distance between two adjacent vertices.
+         *
+         * @param order The current positions of the vertices, in the order to be measured.
+         * @return The bandwidth.
+         */
+        int64_t Bandwidth(const std::vector<int>& order);
+
+        /**
+         * @brief Creates a copy of the vertices allocated in a new order, with the same ids, adjacencies (in the
+         * same order in each list) and colors. Only the memory layout changes: the new list keeps the vertices
+         * in their current positions. The original vertices are not changed.
+         *
+         * @param order The current positions of the vertices, in the order they are allocated.
+         * @param arena Arena where the copies are allocated, or nullptr to allocate them with new.
+         * @return A new list with the copies, which must be deleted by the caller.
+         */
+        LinkedList<Vertex*>* Rebuild(const std::vector<int>& order, MonotonicArena* arena = nullptr);
+
+        /**
+         * @brief Converts the name of an order ("none", "degree", "bfs" or "rcm") to the order.
+         *
+         * @param name The name.
+         * @return The order.
+         * @throw invalid_relabel_order_exception If the name is unknown.
+         */
+        static RelabelOrder ParseOrder(const std::string& name);
+
+        /**
+         * @brief Returns the name of an order, as accepted by ParseOrder.
+         *
+         * @param order The order.
+         * @return The name.
+         */
+        static const char* OrderName(RelabelOrder order);
+};
+
+#endif
@@ -0,0 +1,441 @@
+#include <map>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+
+#include "Graph.hpp"
+#include "GraphGenerator.hpp"
+#include "OutputWriter.hpp"
+#include "MonotonicArena.hpp"
+#include "VertexRelabeler.hpp"
+#include "StreamingVerifier.hpp"
+#include "MultiColoringVerifier.hpp"
+#include "SharedGraph.hpp"
+#include "ShardedVerifier.hpp"
+
+#define SUCCESS (00)
+#define FAILURE (01)
+
+#define DEFAULT_SIZES "1000,10000,100000"
+#define DEFAULT_MODELS "er,powerlaw,dense,grid"
+#define DEFAULT_ORDERERS "bsiqmpylvntea"
+#define DEFAULT_RELABEL_ORDERS "degree,bfs,rcm"
+#define DEFAULT_DEGREE (8.0)
+#define DEFAULT_REPEAT (3)
+#define DEFAULT_BUDGET (1.0)
+#define DENSE_MAX_VERTICES (4096)
+
+/**
+ * Opções do benchmark, lidas da linha de comando.
+ */
+struct BenchOptions
+{
+    std::vector<int> sizes;
+    std::vector<GraphModel> models;
+    std::vector<RelabelOrder> relabelOrders;
+    std::string orderers = DEFAULT_ORDERERS;
+    std::vector<std::string> skipped;
+    double degree = DEFAULT_DEGREE;
+    int repeat = DEFAULT_REPEAT;
+    double budget = DEFAULT_BUDGET;
+    uint64_t seed = 1;
+    bool json = false;
+};
+
+/**
+ * Resultado de uma operação medida em um grafo gerado.
+ */
+struct BenchResult
+{
+    std::string model;
+    int vertices;
+    int64_t edges;
+    int colors;
+    std::string operation;
+    int repeat;
+    double minimum;
+    double median;
+};
+
+/**
+ * Divide uma lista separada por vírgulas.
+ */
+std::vector<std::string> SplitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty())
+            items.push_back(item);
+    }
+
+    return items;
+}
+
+/**
+ * Lê as opções da linha de comando, retornando false se alguma for inválida.
+ */
+bool ParseBenchOptions(int argc, char const *argv[], BenchOptions& options)
+{
+    std::string sizes = DEFAULT_SIZES, models = DEFAULT_MODELS, relabelOrders = DEFAULT_RELABEL_ORDERS;
+
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (argument == "--sizes" && hasValue)
+                sizes = argv[++i];
+            else if (argument == "--models" && hasValue)
+                models = argv[++i];
+            else if (argument == "--orderers" && hasValue)
+                options.orderers = argv[++i];
+            else if (argument == "--relabel" && hasValue)
+                relabelOrders = argv[++i];
+            else if (argument == "--skip" && hasValue)
+                options.skipped = SplitList(argv[++i]);
+            else if (argument == "--degree" && hasValue)
+                options.degree = std::stod(argv[++i]);
+            else if (argument == "--repeat" && hasValue)
+                options.repeat = std::stoi(argv[++i]);
+            else if (argument == "--budget" && hasValue)
+                options.budget = std::stod(argv[++i]);
+            else if (argument == "--seed" && hasValue)
+                options.seed = std::stoull(argv[++i]);
+            else if (argument == "--json")
+                options.json = true;
+            else if (argument == "--csv")
+                options.json = false;
+            else
+                return false;
+        }
+
+        for (const std::string& size : SplitList(sizes))
+            options.sizes.push_back((int)std::stod(size));
+
+        for (const std::string& model : SplitList(models))
+            options.models.push_back(GraphGenerator::ParseModel(model));
+
+        for (const std::string& order : SplitList(relabelOrders))
+            options.relabelOrders.push_back(VertexRelabeler::ParseOrder(order));
+    }
+    catch(...)
+    {
+        return false;
+    }
+
+    return options.repeat > 0 && options.degree >= 0 && !options.sizes.empty() && !options.models.empty();
+}
+
+/**
+ * Executa uma operação várias vezes, retornando os tempos em segundos em ordem crescente.
+ * A preparação de cada execução não é medida, e as repetições param quando uma execução passa do orçamento.
+ */
+std::vector<double> Measure(int repeat, double budget, const std::function<void()>& prepare, const std::function<void()>& operation)
+{
+    std::vector<double> times;
+
+    for (int i = 0; i < repeat && (times.empty() || times.back() <= budget); i++)
+    {
+        prepare();
+
+        auto start = std::chrono::steady_clock::now();
+        operation();
+        auto end = std::chrono::steady_clock::now();
+
+        times.push_back(std::chrono::duration<double>(end - start).count());
+    }
+
+    std::sort(times.begin(), times.end());
+
+    return times;
+}
+
+/**
+ * Imprime os resultados em CSV ou em JSON.
+ */
+void PrintResults(const std::vector<BenchResult>& results, bool json)
+{
+    std::cout.precision(9);
+    std::cout << std::fixed;
+
+    if (!json)
+    {
+        std::cout << "model,vertices,edges,colors,operation,repeat,min_seconds,median_seconds" << std::endl;
+
+        for (const BenchResult& result : results)
+        {
+            std::cout << result.model << "," << result.vertices << "," << result.edges << "," << result.colors << ","
+                      << result.operation << "," << result.repeat << "," << result.minimum << "," << result.median << std::endl;
+        }
+
+        return;
+    }
+
+    std::cout << "[" << std::endl;
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult& result = results[i];
+
+        std::cout << "  {\"model\": \"" << result.model << "\", \"vertices\": " << result.vertices
+                  << ", \"edges\": " << result.edges << ", \"colors\": " << result.colors
+                  << ", \"operation\": \"" << result.operation << "\", \"repeat\": " << result.repeat
+                  << ", \"min_seconds\": " << result.minimum << ", \"median_seconds\": " << result.median << "}"
+                  << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+
+    std::cout << "]" << std::endl;
+}
+
+/**
+ * Mede todas as operações nos grafos de um modelo, em tamanhos crescentes.
+ */
+void BenchModel(const BenchOptions& options, GraphModel model, std::vector<BenchResult>& results)
+{
+    // Último tamanho e tempo de cada operação. Uma operação é ignorada quando, mesmo crescendo
+    // apenas linearmente, passaria do orçamento de tempo no próximo tamanho
+    std::map<std::string, std::pair<int, double>> previous;
+
+    std::vector<int> sizes = options.sizes;
+    std::sort(sizes.begin(), sizes.end());
+
+    for (int size : sizes)
+    {
+        if (model == DENSE && size > DENSE_MAX_VERTICES)
+        {
+            std::cerr << "Ignorado: dense com " << size << " vértices (máximo " << DENSE_MAX_VERTICES << ")" << std::endl;
+            continue;
+        }
+
+        // Geração do grafo, da sua coloração gulosa e do texto de entrada
+        auto start = std::chrono::steady_clock::now();
+        GraphGenerator generator(model, size, options.degree, options.seed);
+        double generation = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::string text;
+        {
+            OutputWriter output(text);
+            generator.Write(output, 'a');
+        }
+
+        Graph* graph = generator.BuildGraph('a');
+
+        auto record = [&](const std::string& operation, const std::vector<double>& times) {
+            results.push_back({ GraphGenerator::ModelName(model), size, generator.EdgeCount(), generator.ColorCount(),
+                                operation, (int)times.size(), times.front(), times[times.size() / 2] });
+
+            previous[operation] = { size, times[times.size() / 2] };
+        };
+
+        auto skipped = [&](const std::string& operation) {
+            if (std::find(options.skipped.begin(), options.skipped.end(), operation) != options.skipped.end())
+                return true;
+
+            if (previous.count(operation) == 0)
+                return false;
+
+            double projected = previous[operation].second * size / previous[operation].first;
+            if (projected <= options.budget)
+                return false;
+
+            std::cerr << "Ignorado: " << operation << " com " << size << " vértices (" << GraphGenerator::ModelName(model)
+                      << "), estimativa de " << projected << " s acima do orçamento" << std::endl;
+            return true;
+        };
+
+        record("generate", { generation });
+
+        if (!skipped("build"))
+        {
+            Graph* built = nullptr;
+            record("build", Measure(options.repeat, options.budget, [&] { delete built; built = nullptr; }, [&] {
+                std::istringstream input(text);
+                built = Graph::BuildFromIoStream(input);
+            }));
+            delete built;
+        }
+
+        if (!skipped("is_greedy"))
+        {
+            bool isGreedy = false;
+            record("is_greedy", Measure(options.repeat, options.budget, [] {}, [&] { isGreedy = graph->IsGreedy(); }));
+
+            if (!isGreedy)
+                std::cerr << "Aviso: a coloração gerada não foi reconhecida como gulosa!" << std::endl;
+        }
+
+        // Rejeição de uma coloração com um vértice fora da regra gulosa
+        if (!skipped("is_greedy_reject"))
+        {
+            GraphGenerator brokenGenerator = generator;
+            brokenGenerator.BreakGreedy();
+            Graph* broken = brokenGenerator.BuildGraph('a');
+
+            bool isGreedy = true;
+            record("is_greedy_reject", Measure(options.repeat, options.budget, [] {}, [&] { isGreedy = broken->IsGreedy(); }));
+
+            if (isGreedy)
+                std::cerr << "Aviso: a coloração alterada foi reconhecida como gulosa!" << std::endl;
+
+            delete broken;
+        }
+
+        // Verificação do texto sem construir o grafo (-s), a comparar com build e is_greedy
+        if (!skipped("stream"))
+        {
+            std::string answer;
+            record("stream", Measure(options.repeat, options.budget, [&] { answer.clear(); }, [&] {
+                std::istringstream input(text);
+                OutputWriter output(answer);
+                StreamingVerifier::Run(input, output);
+            }));
+        }
+
+        // Um bloco de colorações iguais verificadas de uma só vez (-C), a comparar com o mesmo número de build e is_greedy
+        if (!skipped("colorings"))
+        {
+            std::string colorLine = text.substr(text.rfind('\n', text.size() - 2) + 1);
+            std::string colorings = text;
+
+            for (int i = 1; i < COLORING_BLOCK_SIZE; i++)
+                colorings += colorLine;
+
+            std::string answers;
+            long answered = 0;
+            record("colorings", Measure(options.repeat, options.budget, [&] { answers.clear(); }, [&] {
+                std::istringstream input(colorings);
+                OutputWriter output(answers);
+                answered = MultiColoringVerifier::Run(input, output);
+            }));
+
+            if (answered != COLORING_BLOCK_SIZE)
+                std::cerr << "Aviso: " << answered << " colorações respondidas de " << COLORING_BLOCK_SIZE << "!" << std::endl;
+        }
+
+        // Cópia para a memória compartilhada e verificação em um processo (-p 1)
+        if (!skipped("sharded"))
+        {
+            bool isGreedy = false;
+            record("sharded", Measure(options.repeat, options.budget, [] {}, [&] {
+                SharedGraph shared(graph);
+                ShardedVerifier verifier(shared, 1);
+                isGreedy = verifier.Run();
+            }));
+
+            if (!isGreedy)
+                std::cerr << "Aviso: a coloração gerada não foi reconhecida como gulosa pelos processos!" << std::endl;
+        }
+
+        // Reconstrução dos vértices em cada ordem de localidade, e a verificação do grafo reconstruído
+        for (RelabelOrder order : options.relabelOrders)
+        {
+            std::string name = VertexRelabeler::OrderName(order);
+            if (skipped("relabel_" + name))
+                continue;
+
+            // Em uma arena, como no programa, que é liberada junto com o grafo
+            MonotonicArena arena;
+            Graph* relabeled = nullptr;
+
+            record("relabel_" + name, Measure(options.repeat, options.budget, [&] {
+                delete relabeled;
+                relabeled = generator.BuildGraph('a', &arena);
+            }, [&] { relabeled->Relabel(order); }));
+
+            bool isGreedy = false;
+            record("is_greedy_" + name, Measure(options.repeat, options.budget, [] {}, [&] { isGreedy = relabeled->IsGreedy(); }));
+
+            if (!isGreedy)
+                std::cerr << "Aviso: a coloração reconstruída não foi reconhecida como gulosa!" << std::endl;
+
+            delete relabeled;
+        }
+
+        // Destruição de um grafo alocado com new, vértice por vértice, e de um alocado em uma arena
+        for (bool useArena : { false, true })
+        {
+            std::string operation = useArena ? "teardown_arena" : "teardown";
+            if (skipped(operation))
+                continue;
+
+            MonotonicArena arena;
+            Graph* built = nullptr;
+
+            record(operation, Measure(options.repeat, options.budget, [&] {
+                built = generator.BuildGraph('a', useArena ? &arena : nullptr);
+            }, [&] { delete built; }));
+        }
+
+        for (char option : options.orderers)
+        {
+            std::string operation = std::string("sort_") + option;
+            if (skipped(operation))
+                continue;
+
+            GraphOrderer orderer(option);
+            LinkedList<Vertex*>* list = nullptr;
+
+            // Cada execução ordena uma cópia nova da lista, na ordem de inserção
+            record(operation, Measure(options.repeat, options.budget, [&] {
+                delete list;
+                list = new LinkedList<Vertex*>();
+
+                for (Node<Vertex*>* node = graph->GetVertices()->GetNode(0); node != nullptr; node = node->next)
+                    list->Insert(node->data);
+            }, [&] { orderer.Sort(list); }));
+
+            delete list;
+        }
+
+        delete graph;
+    }
+}
+
+int main(int argc, char const *argv[])
+{
+    BenchOptions options;
+
+    if (!ParseBenchOptions(argc, argv, options))
+    {
+        std::cerr << "Uso: bench [--sizes 1000,10000] [--models " << DEFAULT_MODELS << "] [--orderers " << DEFAULT_ORDERERS
+                  << "] [--relabel " << DEFAULT_RELABEL_ORDERS << "] [--skip build,stream,sort_b] [--degree <grau médio>] [--repeat <vezes>] [--budget <segundos>] [--seed <semente>] [--csv | --json]" << std::endl;
+        return FAILURE;
+    }
+
+    std::vector<BenchResult> results;
+
+    try
+    {
+        for (GraphModel model : options.models)
+            BenchModel(options, model, results);
+    }
+    catch(invalid_orderer_option_exception)
+    {
+        std::cerr << "O método de ordenação escolhido é inválido!" << std::endl;
+        return FAILURE;
+    }
+    catch(shared_memory_exception)
+    {
+        std::cerr << "Não foi possível criar a memória compartilhada da verificação!" << std::endl;
+        return FAILURE;
+    }
+    catch(worker_process_exception)
+    {
+        std::cerr << "Um processo da verificação não pôde ser criado ou terminou sem resposta!" << std::endl;
+        return FAILURE;
+    }
+
+    PrintResults(results, options.json);
+
+    return SUCCESS;
+}
@@ -0,0 +1,157 @@
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <iostream>
+
+#include "GraphGenerator.hpp"
+#include "GraphOrderer.hpp"
+#include "OutputWriter.hpp"
+
+#define SUCCESS (00)
+#define FAILURE (01)
+
+#define DEFAULT_VERTICES (1000)
+#define DEFAULT_DEGREE (8.0)
+
+/**
+ * Opções do gerador, lidas da linha de comando.
+ */
+struct GeneratorOptions
+{
+    int vertices = DEFAULT_VERTICES;
+    double degree = DEFAULT_DEGREE;
+    GraphModel model = ERDOS_RENYI;
+    uint64_t seed = 1;
+    char sortOption = 'a';
+    bool greedy = true;
+    int firstCount = -1;
+    std::string output;
+    std::string expected;
+};
+
+/**
+ * Lê as opções da linha de comando, retornando false se alguma for inválida.
+ */
+bool ParseGeneratorOptions(int argc, char const *argv[], GeneratorOptions& options)
+{
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string argument = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if ((argument == "-n" || argument == "--vertices") && hasValue)
+                options.vertices = (int)std::stod(argv[++i]);
+            else if ((argument == "-d" || argument == "--degree") && hasValue)
+                options.degree = std::stod(argv[++i]);
+            else if ((argument == "-g" || argument == "--model") && hasValue)
+                options.model = GraphGenerator::ParseModel(argv[++i]);
+            else if ((argument == "-s" || argument == "--seed") && hasValue)
+                options.seed = std::stoull(argv[++i]);
+            else if ((argument == "-x" || argument == "--sort") && hasValue && std::string(argv[i + 1]).size() == 1)
+                options.sortOption = argv[++i][0];
+            else if ((argument == "-k" || argument == "--first") && hasValue)
+                options.firstCount = std::stoi(argv[++i]);
+            else if ((argument == "-o" || argument == "--output") && hasValue)
+                options.output = argv[++i];
+            else if ((argument == "-e" || argument == "--expected") && hasValue)
+                options.expected = argv[++i];
+            else if (argument == "--yes")
+                options.greedy = true;
+            else if (argument == "--no")
+                options.greedy = false;
+            else
+                return false;
+        }
+
+        // Apenas valida o método de ordenação escrito na entrada
+        GraphOrderer orderer(options.sortOption);
+    }
+    catch(...)
+    {
+        return false;
+    }
+
+    return options.vertices > 0 && options.degree >= 0;
+}
+
+/**
+ * Abre um arquivo para escrita, ou retorna a saída padrão se o caminho for vazio.
+ */
+int OpenOutput(const std::string& path)
+{
+    if (path.empty())
+        return STDOUT_FILENO;
+
+    return open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+int main(int argc, char const *argv[])
+{
+    GeneratorOptions options;
+
+    if (!ParseGeneratorOptions(argc, argv, options))
+    {
+        std::cerr << "Uso: generator [-n <vértices>] [-d <grau médio>] [-g er|powerlaw|dense|grid] [-s <semente>] [-x <ordenação>]"
+                  << " [--yes | --no] [-k <quantidade>] [-o <entrada>] [-e <saída esperada>]" << std::endl;
+        return FAILURE;
+    }
+
+    int outputDescriptor = OpenOutput(options.output);
+    if (outputDescriptor < 0)
+    {
+        std::cerr << "Não foi possível criar o arquivo " << options.output << "!" << std::endl;
+        return FAILURE;
+    }
+
+    try
+    {
+        GraphGenerator generator(options.model, options.vertices, options.degree, options.seed);
+
+        if (!options.greedy)
+            generator.BreakGreedy();
+
+        // O texto é formatado direto no buffer e escrito em blocos, sem montar a entrada inteira na memória
+        {
+            OutputWriter output(outputDescriptor);
+            generator.Write(output, options.sortOption);
+        }
+
+        if (!options.expected.empty())
+        {
+            int expectedDescriptor = OpenOutput(options.expected);
+            if (expectedDescriptor < 0)
+            {
+                std::cerr << "Não foi possível criar o arquivo " << options.expected << "!" << std::endl;
+                return FAILURE;
+            }
+
+            {
+                OutputWriter expected(expectedDescriptor);
+                generator.WriteExpected(expected, options.sortOption, options.firstCount);
+            }
+
+            close(expectedDescriptor);
+        }
+
+        std::cerr << GraphGenerator::ModelName(options.model) << ": " << generator.VertexCount() << " vértices, "
+                  << generator.EdgeCount() << " arestas, " << generator.ColorCount() << " cores, "
+                  << (generator.IsGreedyColoring() ? "coloração gulosa" : "coloração não gulosa") << std::endl;
+    }
+    catch(output_write_exception)
+    {
+        std::cerr << "Não foi possível escrever a saída!" << std::endl;
+        return FAILURE;
+    }
+    catch(const std::bad_alloc&)
+    {
+        std::cerr << "Memória insuficiente para gerar o grafo!" << std::endl;
+        return FAILURE;
+    }
+
+    if (outputDescriptor != STDOUT_FILENO)
+        close(outputDescriptor);
+
+    return SUCCESS;
+}
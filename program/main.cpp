@@ -1,30 +1,333 @@
 #include <string>
+#include <fstream>
 #include <iostream>
+#include <csignal>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
 
 #include "Graph.hpp"
+#include "GraphRunner.hpp"
+#include "ProgramOptions.hpp"
+#include "ExternalSorter.hpp"
+#include "OutputWriter.hpp"
+#include "BinaryPermutation.hpp"
+#include "GraphServer.hpp"
+#include "BatchRunner.hpp"
+#include "GraphPipeline.hpp"
+#include "MultiColoringVerifier.hpp"
+#include "StreamingVerifier.hpp"
+#include "MappedFileStream.hpp"
+#include "FileDescriptorStream.hpp"
+#include "MonotonicArena.hpp"
+#include "ShardedVerifier.hpp"
+#include "Stats.hpp"
 
 #define SUCCESS (00)
 #define FAILURE (01)
 
+/**
+ * Relata as estatísticas coletadas, caso tenham sido pedidas na linha de comando.
+ */
+void ReportStats(ProgramOptions& options)
+{
+    if (!options.IsStats() && options.GetStatsTracePath() == nullptr)
+        return;
+
+#ifdef GRAPH_STATS
+    if (options.IsStats())
+        Stats::WriteReport(std::cerr);
+
+    if (options.GetStatsTracePath() != nullptr)
+    {
+        std::ofstream trace(options.GetStatsTracePath());
+        Stats::WriteTrace(trace);
+
+        if (!trace)
+            std::cerr << "Não foi possível escrever o arquivo de rastreamento!" << std::endl;
+    }
+#else
+    std::cerr << "Estatísticas indisponíveis: compile o programa com make STATS=1" << std::endl;
+#endif
+}
+
 int main(int argc, char const *argv[])
 {   
     try
     {
-        // Construção do grafo com os dados da entrada padrão
-        Graph* graph = Graph::BuildFromIoStream();
+        // Leitura das opções da linha de comando
+        ProgramOptions options = ProgramOptions::Parse(argc, argv);
+
+        if (options.GetMemoryBudget() != DEFAULT_MEMORY_BUDGET)
+            GraphOrderer::SetExternalMemoryBudget(options.GetMemoryBudget());
+
+#ifdef GRAPH_STATS
+        // Contadores de hardware, quando o sistema permite abri-los
+        if (options.IsPerf() && !Stats::EnableHardwareCounters())
+            std::cerr << "Contadores de hardware indisponíveis (perf_event_open), apenas os tempos e as operações serão relatados" << std::endl;
+#endif
+
+        // Execução como servidor, até o recebimento de SIGINT ou SIGTERM
+        if (options.GetSocketPath() != nullptr)
+        {
+            sigset_t signals;
+            sigemptyset(&signals);
+            sigaddset(&signals, SIGINT);
+            sigaddset(&signals, SIGTERM);
+            pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+            GraphServer server(options.GetSocketPath(), options.GetWorkerCount(), options.GetFirstCount());
+            server.Start();
+
+            int signal;
+            sigwait(&signals, &signal);
+            server.Stop();
+
+            std::cerr << "Requisições atendidas: " << server.RequestCount() 
+                      << " (latência em µs: p50 " << server.LatencyPercentile(50) 
+                      << ", p90 " << server.LatencyPercentile(90) 
+                      << ", p99 " << server.LatencyPercentile(99) << ")" << std::endl;
+
+            ReportStats(options);
+            return SUCCESS;
+        }
+
+        // Verificação em lote dos arquivos de um diretório ou padrão
+        if (options.GetBatchPattern() != nullptr)
+        {
+            BatchRunner batch(options.GetBatchPattern(), options.GetWorkerCount(), options.GetFirstCount());
+            batch.Run();
+
+            int outputFile = STDOUT_FILENO;
+            if (options.GetOutputPath() != nullptr)
+                outputFile = open(options.GetOutputPath(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+            if (outputFile < 0)
+                throw output_write_exception();
+
+            OutputWriter output(outputFile);
+            batch.WriteResults(output);
+            output.Flush();
+
+            if (outputFile != STDOUT_FILENO)
+                close(outputFile);
+
+            if (options.IsVerbose())
+                std::cerr << "Arquivos verificados: " << batch.FileCount() << " (" << batch.StolenCount() << " roubados entre as threads)" << std::endl;
+
+            ReportStats(options);
+            return SUCCESS;
+        }
+
+        // Sequência de grafos da entrada padrão, com leitura, verificação e escrita simultâneas
+        if (options.IsPipeline())
+        {
+            FileDescriptorStreamBuffer inputBuffer(STDIN_FILENO);
+            std::istream input(&inputBuffer);
+
+            int outputFile = STDOUT_FILENO;
+            if (options.GetOutputPath() != nullptr)
+                outputFile = open(options.GetOutputPath(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+            if (outputFile < 0)
+                throw output_write_exception();
+
+            OutputWriter output(outputFile);
+            long answers = GraphPipeline(input, output, options.GetFirstCount()).Run();
+
+            if (outputFile != STDOUT_FILENO)
+                close(outputFile);
+
+            if (options.IsVerbose())
+                std::cerr << "Grafos processados: " << answers << std::endl;
+
+            ReportStats(options);
+            return SUCCESS;
+        }
+
+        // Várias colorações do mesmo grafo, verificadas em blocos sobre uma única cópia das adjacências
+        if (options.IsColorings())
+        {
+            FileDescriptorStreamBuffer inputBuffer(STDIN_FILENO);
+            std::istream input(&inputBuffer);
+
+            int outputFile = STDOUT_FILENO;
+            if (options.GetOutputPath() != nullptr)
+                outputFile = open(options.GetOutputPath(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+            if (outputFile < 0)
+                throw output_write_exception();
+
+            OutputWriter output(outputFile);
+            long answers = MultiColoringVerifier::Run(input, output, options.GetFirstCount());
+
+            if (outputFile != STDOUT_FILENO)
+                close(outputFile);
+
+            if (options.IsVerbose())
+                std::cerr << "Colorações verificadas: " << answers << " (em blocos de " << COLORING_BLOCK_SIZE << ")" << std::endl;
+
+            ReportStats(options);
+            return SUCCESS;
+        }
+
+        // Verificação em duas passagens sobre o arquivo mapeado em memória, sem construir o grafo
+        if (options.GetStreamPath() != nullptr)
+        {
+            std::string path = options.GetStreamPath();
+            MappedFileStreamBuffer inputBuffer(path == "-" ? "/dev/stdin" : path.c_str());
+            std::istream input(&inputBuffer);
+
+            int outputFile = STDOUT_FILENO;
+            if (options.GetOutputPath() != nullptr)
+                outputFile = open(options.GetOutputPath(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+            if (outputFile < 0)
+                throw output_write_exception();
+
+            OutputWriter output(outputFile);
+            bool processed = StreamingVerifier::Run(input, output, options.GetFirstCount());
+            output.Flush();
+
+            if (outputFile != STDOUT_FILENO)
+                close(outputFile);
+
+            ReportStats(options);
+            return processed ? SUCCESS : FAILURE;
+        }
+
+        // Construção do grafo com os dados da entrada padrão, com vértices, listas e nós em uma arena
+        // liberada de uma só vez ao final, conferindo que a entrada não terminou antes do grafo estar completo
+        MonotonicArena arena;
+        Graph* graph = GraphRunner::Build(std::cin, &arena);
+
+        // Reconstrução opcional dos vértices em uma ordem com vizinhos próximos na memória
+        graph->Relabel(options.GetRelabelOrder());
         
-        // Impressão se o grafo é "guloso" ou não
-        bool isGreedy = graph->IsGreedy();
-        std::cout << isGreedy;
+        // Verificação se o grafo é "guloso" ou não, no próprio programa ou em processos que leem uma
+        // cópia do grafo em memória compartilhada
+        bool isGreedy;
 
-        // Impressão dos vértices ordenados caso seja guloso
-        if (isGreedy)
-            std::cout << " " << graph->OrderedVertices();
-            
-        std::cout << std::endl;
+        if (options.GetProcessCount() > 0)
+        {
+            STATS_PHASE("is_greedy");
+
+            SharedGraph shared(graph);
+            ShardedVerifier verifier(shared, options.GetProcessCount(), options.IsNuma());
+            isGreedy = verifier.Run();
+
+            if (options.IsVerbose())
+            {
+                std::cerr << "Verificação com " << options.GetProcessCount() << " processos (" 
+                          << shared.Size() << " bytes compartilhados, " 
+                          << verifier.PinnedCount() << " fixados em nós NUMA, " 
+                          << verifier.StoppedCount() << " interrompidos)";
+
+                if (!isGreedy)
+                    std::cerr << ", vértice não guloso: " << shared.FailedId();
+
+                std::cerr << std::endl;
+            }
+        }
+        else
+            isGreedy = graph->IsGreedy();
+
+        // Escrita da resposta
+        {
+            STATS_PHASE("output");
+
+            if (options.IsBinary() && options.GetOutputPath() != nullptr)
+            {
+                // Saída binária diretamente no arquivo mapeado em memória
+                BinaryPermutation::WriteMapped(options.GetOutputPath(), isGreedy, graph, options.GetFirstCount());
+            }
+            else
+            {
+                int outputFile = STDOUT_FILENO;
+                if (options.GetOutputPath() != nullptr)
+                    outputFile = open(options.GetOutputPath(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+                if (outputFile < 0)
+                    throw output_write_exception();
+
+                OutputWriter output(outputFile);
+
+                if (options.IsBinary())
+                {
+                    BinaryPermutation::Write(output, isGreedy, graph, options.GetFirstCount());
+                }
+                else
+                {
+                    // Impressão se o grafo é "guloso" ou não e dos vértices ordenados caso seja
+                    // O veredito só é escrito depois da ordenação, para que uma falha dela não deixe uma resposta parcial
+                    if (isGreedy && options.GetFirstCount() != 0)
+                        graph->WriteOrderedVertices(output, options.GetFirstCount(), "1 ");
+                    else
+                        output.WriteInt(isGreedy);
+
+                    output.WriteChar('\n');
+                }
+
+                output.Flush();
+
+                if (outputFile != STDOUT_FILENO)
+                    close(outputFile);
+            }
+        }
+
+        // Relato do método escolhido pela ordenação automática
+        if (options.IsVerbose() && !graph->GetOrderer()->GetChoiceReason().empty())
+            std::cerr << "Ordenação automática: " << graph->GetOrderer()->GetChoiceReason() << std::endl;
 
         // Limpeza da memória alocada
         delete graph;
+
+        ReportStats(options);
+    }
+    catch(invalid_program_argument_exception)
+    {
+        std::cout << "Argumento inválido na linha de comando! Uso: tp2.out [-k <quantidade>] [-v] [-m <bytes>] [-b] [-o <arquivo>] [-S <socket> | -B <diretório|padrão> | -P | -C | -s <arquivo>] [-w <threads>] [-r none|degree|bfs|rcm] [-p <processos>] [--numa] [--stats] [--stats-trace <arquivo>] [--perf]" << std::endl;
+        return FAILURE;
+    }
+    catch(empty_batch_exception)
+    {
+        std::cout << "Nenhum arquivo encontrado para a verificação em lote!" << std::endl;
+        return FAILURE;
+    }
+    catch(server_socket_exception)
+    {
+        std::cout << "Não foi possível criar o socket do servidor!" << std::endl;
+        return FAILURE;
+    }
+    catch(mapped_file_exception)
+    {
+        std::cout << "Não foi possível mapear o arquivo de entrada (deve ser um arquivo regular)!" << std::endl;
+        return FAILURE;
+    }
+    catch(shared_memory_exception)
+    {
+        std::cout << "Não foi possível criar a memória compartilhada da verificação!" << std::endl;
+        return FAILURE;
+    }
+    catch(worker_process_exception)
+    {
+        std::cout << "Um processo da verificação não pôde ser criado ou terminou sem resposta!" << std::endl;
+        return FAILURE;
+    }
+    catch(output_write_exception)
+    {
+        std::cerr << "Não foi possível escrever a saída do programa!" << std::endl;
+        return FAILURE;
+    }
+    catch(external_storage_exception)
+    {
+        std::cout << "Não foi possível usar os arquivos temporários da ordenação externa!" << std::endl;
+        return FAILURE;
+    }
+    catch(malformed_input_exception)
+    {
+        std::cout << "A entrada terminou antes do grafo estar completo ou possui dados inválidos!" << std::endl;
+        return FAILURE;
     }
     catch(element_not_found_exception)
     {
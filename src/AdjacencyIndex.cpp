@@ -0,0 +1,133 @@
+#include <cstring>
+#include <algorithm>
+
+#include "AdjacencyIndex.hpp"
+
+AdjacencyIndex::AdjacencyIndex(MonotonicArena* arena)
+{
+    _arena = arena;
+    _sorted = nullptr;
+    _size = 0;
+    _capacity = 0;
+    _bits = nullptr;
+    _universe = 0;
+}
+
+AdjacencyIndex::~AdjacencyIndex()
+{
+    FreeArray(_sorted);
+    FreeArray(_bits);
+}
+
+template <typename Type>
+Type* AdjacencyIndex::AllocateArray(int count)
+{
+    if (_arena == nullptr)
+        return new Type[count];
+
+    return (Type*)_arena->Allocate(sizeof(Type) * count, alignof(Type));
+}
+
+template <typename Type>
+void AdjacencyIndex::FreeArray(Type* array)
+{
+    if (_arena == nullptr)
+        delete[] array;
+}
+
+int AdjacencyIndex::GallopFromEnd(int id) const
+{
+    if (_size == 0 || _sorted[_size - 1] < id)
+        return _size;
+
+    // Doubles the step until an id less than the searched one is found, then searches in the last step
+    int high = _size - 1, step = 1;
+    while (high - step >= 0 && _sorted[high - step] >= id)
+    {
+        high -= step;
+        step *= 2;
+    }
+
+    int low = std::max(high - step, 0);
+    return std::lower_bound(_sorted + low, _sorted + high, id) - _sorted;
+}
+
+bool AdjacencyIndex::Contains(int id) const
+{
+    if (id >= 0 && id < _universe)
+        return (_bits[id >> 6] >> (id & 63)) & 1;
+
+    return std::binary_search(_sorted, _sorted + _size, id);
+}
+
+void AdjacencyIndex::Insert(int id)
+{
+    if (id >= 0 && id < _universe)
+    {
+        _bits[id >> 6] |= (uint64_t)1 << (id & 63);
+        return;
+    }
+
+    if (_size == _capacity)
+        Reserve(std::max(4, _capacity * 2));
+
+    int position = GallopFromEnd(id);
+    std::memmove(_sorted + position + 1, _sorted + position, sizeof(int) * (_size - position));
+
+    _sorted[position] = id;
+    _size++;
+}
+
+void AdjacencyIndex::Reserve(int capacity)
+{
+    if (capacity <= _capacity)
+        return;
+
+    int* sorted = AllocateArray<int>(capacity);
+    if (_size > 0)
+        std::memcpy(sorted, _sorted, sizeof(int) * _size);
+
+    FreeArray(_sorted);
+    _sorted = sorted;
+    _capacity = capacity;
+}
+
+void AdjacencyIndex::UseBitset(int universe)
+{
+    if (_bits != nullptr || universe <= 0)
+        return;
+
+    int words = (universe + 63) / 64;
+    _bits = AllocateArray<uint64_t>(words);
+    std::memset(_bits, 0, sizeof(uint64_t) * words);
+    _universe = universe;
+
+    // Only the ids outside of the row stay in the sorted array
+    int kept = 0;
+    for (int i = 0; i < _size; i++)
+    {
+        int id = _sorted[i];
+
+        if (id >= 0 && id < _universe)
+            _bits[id >> 6] |= (uint64_t)1 << (id & 63);
+        else
+            _sorted[kept++] = id;
+    }
+
+    _size = kept;
+}
+
+bool AdjacencyIndex::IsBitset() const
+{
+    return _bits != nullptr;
+}
+
+size_t AdjacencyIndex::MemoryBytes() const
+{
+    return sizeof(int) * _capacity + (_bits == nullptr ? 0 : sizeof(uint64_t) * ((_universe + 63) / 64));
+}
+
+int AdjacencyIndex::BitsetThreshold(int vertexCount)
+{
+    return std::max(MIN_BITSET_DEGREE, vertexCount / BITSET_DEGREE_DIVISOR);
+}
@@ -0,0 +1,186 @@
+#include <glob.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <istream>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
+
+#include "BatchRunner.hpp"
+#include "GraphRunner.hpp"
+#include "FileDescriptorStream.hpp"
+
+BatchRunner::BatchRunner(const char* pattern, int workerCount, int firstCount)
+    : _queues(workerCount < 1 ? 1 : workerCount)
+{
+    _firstCount = firstCount;
+    _stolenCount = 0;
+
+    for (const std::string& path : ExpandPattern(pattern))
+    {
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(path, error);
+
+        _jobs.push_back({ path, error ? 0 : (size_t)size, "" });
+    }
+
+    if (_jobs.empty())
+        throw empty_batch_exception();
+}
+
+std::vector<std::string> BatchRunner::ExpandPattern(const char* pattern)
+{
+    std::vector<std::string> paths;
+    std::error_code error;
+
+    if (std::filesystem::is_directory(pattern, error))
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(pattern, error))
+        {
+            if (entry.is_regular_file(error))
+                paths.push_back(entry.path().string());
+        }
+    }
+    else
+    {
+        glob_t matches;
+
+        if (glob(pattern, 0, nullptr, &matches) == 0)
+        {
+            for (size_t i = 0; i < matches.gl_pathc; i++)
+            {
+                if (std::filesystem::is_regular_file(matches.gl_pathv[i], error))
+                    paths.push_back(matches.gl_pathv[i]);
+            }
+        }
+
+        globfree(&matches);
+    }
+
+    std::sort(paths.begin(), paths.end());
+
+    return paths;
+}
+
+void BatchRunner::Run()
+{
+    // Largest files first, dealt in turns so every worker starts with one of the biggest
+    std::vector<size_t> order(_jobs.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), [this](size_t first, size_t second) {
+        return _jobs[first].size > _jobs[second].size;
+    });
+
+    for (WorkerQueue& queue : _queues)
+        queue.jobs.clear();
+
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        _jobs[order[i]].result.clear();
+        _queues[i % _queues.size()].jobs.push_back(order[i]);
+    }
+
+    _stolenCount = 0;
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < _queues.size(); i++)
+        workers.emplace_back(&BatchRunner::WorkerLoop, this, (int)i);
+
+    WorkerLoop(0);
+
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+bool BatchRunner::NextJob(int worker, size_t& job)
+{
+    {
+        WorkerQueue& own = _queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+
+        if (!own.jobs.empty())
+        {
+            job = own.jobs.front();
+            own.jobs.pop_front();
+            return true;
+        }
+    }
+
+    for (size_t offset = 1; offset < _queues.size(); offset++)
+    {
+        WorkerQueue& victim = _queues[(worker + offset) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.jobs.empty())
+        {
+            job = victim.jobs.back();
+            victim.jobs.pop_back();
+            _stolenCount++;
+            return true;
+        }
+    }
+
+    // No job is ever added during a run, so empty queues mean the work is over
+    return false;
+}
+
+void BatchRunner::WorkerLoop(int worker)
+{
+    // Buffers reused by every file processed by this worker
+    FileDescriptorStreamBuffer inputBuffer(-1);
+    std::istream input(&inputBuffer);
+    OutputWriter output(-1);
+    MonotonicArena arena;
+
+    size_t index;
+    while (NextJob(worker, index))
+    {
+        BatchJob& job = _jobs[index];
+        output.Redirect(job.result);
+
+        int file = open(job.path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            const char* message = "Não foi possível ler o arquivo de entrada!\n";
+            output.WriteBytes(message, strlen(message));
+        }
+        else
+        {
+            inputBuffer.Reset(file);
+            input.clear();
+
+            GraphRunner::Run(input, output, _firstCount, &arena);
+            close(file);
+        }
+
+        output.Flush();
+    }
+}
+
+void BatchRunner::WriteResults(OutputWriter& output)
+{
+    for (const BatchJob& job : _jobs)
+    {
+        output.WriteBytes(job.path.c_str(), job.path.size());
+        output.WriteBytes(": ", 2);
+        output.WriteBytes(job.result.c_str(), job.result.size());
+    }
+}
+
+size_t BatchRunner::FileCount()
+{
+    return _jobs.size();
+}
+
+const BatchJob& BatchRunner::GetJob(size_t index)
+{
+    return _jobs.at(index);
+}
+
+long BatchRunner::StolenCount()
+{
+    return _stolenCount;
+}
@@ -0,0 +1,167 @@
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "BinaryPermutation.hpp"
+
+#define PERMUTATION_BLOCK_SIZE (1024)
+
+/**
+ * Stores a 32-bit value in little-endian order, regardless of the host byte order.
+ */
+void StoreLittleEndian(char* destiny, uint32_t value)
+{
+    destiny[0] = (char)(value & 0xFF);
+    destiny[1] = (char)((value >> 8) & 0xFF);
+    destiny[2] = (char)((value >> 16) & 0xFF);
+    destiny[3] = (char)((value >> 24) & 0xFF);
+}
+
+uint32_t LoadLittleEndian(const char* source)
+{
+    const unsigned char* bytes = (const unsigned char*)source;
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+int PermutationCount(bool isGreedy, Graph* graph, int count)
+{
+    if (!isGreedy || graph == nullptr)
+        return 0;
+
+    return count < 0 || count > graph->VertexCount() ? graph->VertexCount() : count;
+}
+
+void FillHeader(char* header, bool isGreedy, int count)
+{
+    memcpy(header, BINARY_PERMUTATION_MAGIC, 4);
+    StoreLittleEndian(header + 4, BINARY_PERMUTATION_VERSION);
+    StoreLittleEndian(header + 8, isGreedy ? BINARY_PERMUTATION_GREEDY_FLAG : 0);
+    StoreLittleEndian(header + 12, (uint32_t)count);
+}
+
+size_t BinaryPermutation::Size(int count)
+{
+    return BINARY_PERMUTATION_HEADER_SIZE + (size_t)count * 4;
+}
+
+void BinaryPermutation::Write(OutputWriter& writer, bool isGreedy, Graph* graph, int firstCount)
+{
+    int count = PermutationCount(isGreedy, graph, firstCount);
+
+    char header[BINARY_PERMUTATION_HEADER_SIZE];
+    FillHeader(header, isGreedy, count);
+
+    if (count == 0)
+    {
+        writer.WriteBytes(header, BINARY_PERMUTATION_HEADER_SIZE);
+        return;
+    }
+
+    // Ids are encoded in blocks, so each block costs a single copy into the writer
+    char block[4 * PERMUTATION_BLOCK_SIZE];
+    int blockLength = 0;
+
+    // The header is only written once the vertices are sorted, so a sort that fails writes nothing
+    graph->VisitOrderedVertices(firstCount, [&]() {
+        writer.WriteBytes(header, BINARY_PERMUTATION_HEADER_SIZE);
+    }, [&](Vertex* vertex) {
+        StoreLittleEndian(block + 4 * blockLength++, (uint32_t)vertex->GetId());
+
+        if (blockLength == PERMUTATION_BLOCK_SIZE)
+        {
+            writer.WriteBytes(block, 4 * blockLength);
+            blockLength = 0;
+        }
+    });
+
+    writer.WriteBytes(block, 4 * blockLength);
+}
+
+/**
+ * Creates or truncates a file with the given size and maps it for writing.
+ */
+char* MapOutputFile(const char* path, size_t size)
+{
+    int file = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+        throw output_write_exception();
+
+    if (ftruncate(file, size) != 0)
+    {
+        close(file);
+        throw output_write_exception();
+    }
+
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+
+    if (mapping == MAP_FAILED)
+        throw output_write_exception();
+
+    return (char*)mapping;
+}
+
+void BinaryPermutation::WriteMapped(const char* path, bool isGreedy, Graph* graph, int firstCount)
+{
+    int count = PermutationCount(isGreedy, graph, firstCount);
+    size_t size = Size(count);
+
+    if (count == 0)
+    {
+        char* data = MapOutputFile(path, size);
+        FillHeader(data, isGreedy, count);
+        munmap(data, size);
+
+        return;
+    }
+
+    // The file is only created once the vertices are sorted, so a sort that fails leaves it untouched
+    char* data = nullptr;
+    char* ids = nullptr;
+
+    try
+    {
+        graph->VisitOrderedVertices(firstCount, [&]() {
+            data = MapOutputFile(path, size);
+            FillHeader(data, isGreedy, count);
+            ids = data + BINARY_PERMUTATION_HEADER_SIZE;
+        }, [&](Vertex* vertex) {
+            StoreLittleEndian(ids, (uint32_t)vertex->GetId());
+            ids += 4;
+        });
+    }
+    catch(...)
+    {
+        if (data != nullptr)
+            munmap(data, size);
+
+        throw;
+    }
+
+    munmap(data, size);
+}
+
+int* BinaryPermutation::Read(const char* data, size_t length, bool& isGreedy, int& count)
+{
+    if (length < BINARY_PERMUTATION_HEADER_SIZE || memcmp(data, BINARY_PERMUTATION_MAGIC, 4) != 0)
+        throw invalid_binary_permutation_exception();
+
+    if (LoadLittleEndian(data + 4) != BINARY_PERMUTATION_VERSION)
+        throw invalid_binary_permutation_exception();
+
+    uint32_t storedCount = LoadLittleEndian(data + 12);
+    if (storedCount > 0x7FFFFFFF || length < Size((int)storedCount))
+        throw invalid_binary_permutation_exception();
+
+    isGreedy = (LoadLittleEndian(data + 8) & BINARY_PERMUTATION_GREEDY_FLAG) != 0;
+    count = (int)storedCount;
+
+    int* ids = new int[count];
+    for (int i = 0; i < count; i++)
+    {
+        ids[i] = (int)LoadLittleEndian(data + BINARY_PERMUTATION_HEADER_SIZE + 4 * i);
+    }
+
+    return ids;
+}
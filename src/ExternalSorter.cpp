@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <unistd.h>
+
+#include "ExternalSorter.hpp"
+
+#define INITIAL_BUFFER_CAPACITY (1024)
+
+/**
+ * Writes records at an offset of a temporary file, retrying partial writes.
+ */
+void WriteRecords(FILE* storage, off_t offset, const SortRecord* records, int count)
+{
+    const char* data = (const char*)records;
+    size_t remaining = (size_t)count * sizeof(SortRecord);
+
+    while (remaining > 0)
+    {
+        ssize_t written = pwrite(fileno(storage), data, remaining, offset);
+        if (written <= 0)
+            throw external_storage_exception();
+
+        data += written;
+        offset += written;
+        remaining -= written;
+    }
+}
+
+/**
+ * Reads records from an offset of a temporary file, retrying partial reads. The records must be there.
+ */
+void ReadRecords(FILE* storage, off_t offset, SortRecord* records, int count)
+{
+    char* data = (char*)records;
+    size_t remaining = (size_t)count * sizeof(SortRecord);
+
+    while (remaining > 0)
+    {
+        ssize_t read = pread(fileno(storage), data, remaining, offset);
+        if (read <= 0)
+            throw external_storage_exception();
+
+        data += read;
+        offset += read;
+        remaining -= read;
+    }
+}
+
+ExternalSorter::ExternalSorter(size_t memoryBudget)
+{
+    // A merge needs at least one record for each run it reads and one for the run it writes
+    size_t capacity = memoryBudget / sizeof(SortRecord);
+    _bufferLimit = capacity < EXTERNAL_MERGE_FAN_IN + 1 ? EXTERNAL_MERGE_FAN_IN + 1 : (capacity > 0x7FFFFFFF ? 0x7FFFFFFF : (int)capacity);
+    _bufferCapacity = 0;
+    _buffer = nullptr;
+    _bufferLength = 0;
+    _bufferPosition = 0;
+
+    _storage[0] = nullptr;
+    _storage[1] = nullptr;
+    _storageIndex = 0;
+    _storageEnd = 0;
+    _mergePasses = 0;
+
+    _mergeStorage = nullptr;
+    _mergeRuns = new SortRun[EXTERNAL_MERGE_FAN_IN];
+    _mergeBuffers = new SortRecord*[EXTERNAL_MERGE_FAN_IN];
+    _mergeLengths = new int[EXTERNAL_MERGE_FAN_IN];
+    _mergePositions = new int[EXTERNAL_MERGE_FAN_IN];
+    _mergeHeap = new int[EXTERNAL_MERGE_FAN_IN];
+    _mergeHeapSize = 0;
+    _mergeBufferCapacity = 0;
+
+    _finished = false;
+    _merging = false;
+}
+
+ExternalSorter::~ExternalSorter()
+{
+    for (FILE* storage : _storage)
+    {
+        if (storage != nullptr)
+            fclose(storage);
+    }
+
+    delete[] _buffer;
+
+    delete[] _mergeRuns;
+    delete[] _mergeBuffers;
+    delete[] _mergeLengths;
+    delete[] _mergePositions;
+    delete[] _mergeHeap;
+}
+
+bool ExternalSorter::IsLessThan(const SortRecord& first, const SortRecord& second)
+{
+    if (first.color != second.color)
+        return first.color < second.color;
+
+    return first.id < second.id;
+}
+
+void ExternalSorter::Add(SortRecord record)
+{
+    if (_bufferLength == _bufferCapacity)
+    {
+        if (_bufferCapacity == _bufferLimit)
+        {
+            SpillRun();
+        }
+        else
+        {
+            // The buffer grows up to the budget, small inputs do not reserve all of it
+            int grown = _bufferCapacity < INITIAL_BUFFER_CAPACITY / 2 ? INITIAL_BUFFER_CAPACITY : _bufferCapacity * 2;
+            grown = grown > _bufferLimit || grown < 0 ? _bufferLimit : grown;
+
+            SortRecord* buffer = new SortRecord[grown];
+            std::copy(_buffer, _buffer + _bufferLength, buffer);
+
+            delete[] _buffer;
+            _buffer = buffer;
+            _bufferCapacity = grown;
+        }
+    }
+
+    _buffer[_bufferLength++] = record;
+}
+
+FILE* ExternalSorter::Storage(int index)
+{
+    // The files are only accessed with pread and pwrite, so stdio never allocates a buffer for them
+    if (_storage[index] == nullptr)
+        _storage[index] = tmpfile();
+
+    if (_storage[index] == nullptr)
+        throw external_storage_exception();
+
+    return _storage[index];
+}
+
+void ExternalSorter::SpillRun()
+{
+    std::sort(_buffer, _buffer + _bufferLength, &IsLessThan);
+
+    WriteRecords(Storage(_storageIndex), _storageEnd, _buffer, _bufferLength);
+
+    _runs.push_back({ _storageEnd, _bufferLength });
+    _storageEnd += (off_t)_bufferLength * sizeof(SortRecord);
+    _bufferLength = 0;
+}
+
+void ExternalSorter::MergePass()
+{
+    FILE* source = Storage(_storageIndex);
+    FILE* target = Storage(1 - _storageIndex);
+
+    // The target still holds the runs of the pass before the last one, which were already merged
+    if (ftruncate(fileno(target), 0) != 0)
+        throw external_storage_exception();
+
+    std::vector<SortRun> merged;
+    off_t end = 0;
+
+    for (size_t first = 0; first < _runs.size(); first += EXTERNAL_MERGE_FAN_IN)
+    {
+        int count = (int)std::min(_runs.size() - first, (size_t)EXTERNAL_MERGE_FAN_IN);
+
+        // Each run of the group and the merged run get an equal share of the buffer
+        int share = _bufferCapacity / (count + 1);
+        StartMerge(source, (int)first, count, share);
+
+        SortRecord* output = _buffer + count * share;
+        int outputLength = 0;
+        merged.push_back({ end, 0 });
+
+        auto flush = [&]() {
+            WriteRecords(target, end, output, outputLength);
+
+            end += (off_t)outputLength * sizeof(SortRecord);
+            merged.back().count += outputLength;
+            outputLength = 0;
+        };
+
+        SortRecord record;
+        while (PopMerged(record))
+        {
+            output[outputLength++] = record;
+
+            if (outputLength == share)
+                flush();
+        }
+
+        flush();
+    }
+
+    _runs = merged;
+    _storageIndex = 1 - _storageIndex;
+    _storageEnd = end;
+    _mergePasses++;
+}
+
+void ExternalSorter::StartMerge(FILE* storage, int first, int count, int bufferCapacity)
+{
+    _mergeStorage = storage;
+    _mergeBufferCapacity = bufferCapacity;
+    _mergeHeapSize = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        _mergeRuns[i] = _runs[first + i];
+        _mergeBuffers[i] = _buffer + i * bufferCapacity;
+
+        if (RefillRun(i))
+            _mergeHeap[_mergeHeapSize++] = i;
+    }
+
+    for (int i = _mergeHeapSize / 2 - 1; i >= 0; i--)
+        SiftDown(i);
+}
+
+void ExternalSorter::Finish()
+{
+    if (_finished)
+        return;
+
+    _finished = true;
+
+    if (_runs.empty())
+    {
+        std::sort(_buffer, _buffer + _bufferLength, &IsLessThan);
+        return;
+    }
+
+    if (_bufferLength > 0)
+        SpillRun();
+
+    while (_runs.size() > EXTERNAL_MERGE_FAN_IN)
+        MergePass();
+
+    StartMerge(Storage(_storageIndex), 0, (int)_runs.size(), _bufferCapacity / (int)_runs.size());
+    _merging = true;
+}
+
+bool ExternalSorter::RefillRun(int run)
+{
+    SortRun& source = _mergeRuns[run];
+    int count = source.count < _mergeBufferCapacity ? (int)source.count : _mergeBufferCapacity;
+
+    ReadRecords(_mergeStorage, source.offset, _mergeBuffers[run], count);
+
+    source.offset += (off_t)count * sizeof(SortRecord);
+    source.count -= count;
+
+    _mergeLengths[run] = count;
+    _mergePositions[run] = 0;
+
+    return count > 0;
+}
+
+void ExternalSorter::SiftDown(int index)
+{
+    while (true)
+    {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+
+        auto head = [&](int heapIndex) -> SortRecord& {
+            int run = _mergeHeap[heapIndex];
+            return _mergeBuffers[run][_mergePositions[run]];
+        };
+
+        if (left < _mergeHeapSize && IsLessThan(head(left), head(smallest)))
+            smallest = left;
+
+        if (right < _mergeHeapSize && IsLessThan(head(right), head(smallest)))
+            smallest = right;
+
+        if (smallest == index)
+            return;
+
+        int temp = _mergeHeap[index];
+        _mergeHeap[index] = _mergeHeap[smallest];
+        _mergeHeap[smallest] = temp;
+
+        index = smallest;
+    }
+}
+
+bool ExternalSorter::PopMerged(SortRecord& record)
+{
+    if (_mergeHeapSize == 0)
+        return false;
+
+    int run = _mergeHeap[0];
+    record = _mergeBuffers[run][_mergePositions[run]++];
+
+    if (_mergePositions[run] == _mergeLengths[run] && !RefillRun(run))
+        _mergeHeap[0] = _mergeHeap[--_mergeHeapSize];
+
+    SiftDown(0);
+
+    return true;
+}
+
+bool ExternalSorter::Next(SortRecord& record)
+{
+    if (!_finished)
+        Finish();
+
+    if (!_merging)
+    {
+        if (_bufferPosition >= _bufferLength)
+            return false;
+
+        record = _buffer[_bufferPosition++];
+        return true;
+    }
+
+    return PopMerged(record);
+}
+
+int ExternalSorter::RunCount()
+{
+    return (int)_runs.size();
+}
+
+int ExternalSorter::MergePassCount()
+{
+    return _mergePasses;
+}
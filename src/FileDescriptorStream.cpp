@@ -0,0 +1,44 @@
+#include <cerrno>
+#include <unistd.h>
+
+#include "FileDescriptorStream.hpp"
+
+FileDescriptorStreamBuffer::FileDescriptorStreamBuffer(int fileDescriptor, size_t capacity)
+{
+    _fileDescriptor = fileDescriptor;
+    _capacity = capacity < 1 ? 1 : capacity;
+    _buffer = new char[_capacity];
+
+    setg(_buffer, _buffer, _buffer);
+}
+
+FileDescriptorStreamBuffer::~FileDescriptorStreamBuffer()
+{
+    delete[] _buffer;
+}
+
+FileDescriptorStreamBuffer::int_type FileDescriptorStreamBuffer::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    ssize_t bytes;
+    do
+    {
+        bytes = read(_fileDescriptor, _buffer, _capacity);
+    }
+    while (bytes < 0 && errno == EINTR);
+
+    if (bytes <= 0)
+        return traits_type::eof();
+
+    setg(_buffer, _buffer, _buffer + bytes);
+
+    return traits_type::to_int_type(*gptr());
+}
+
+void FileDescriptorStreamBuffer::Reset(int fileDescriptor)
+{
+    _fileDescriptor = fileDescriptor;
+    setg(_buffer, _buffer, _buffer);
+}
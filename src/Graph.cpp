@@ -1,35 +1,61 @@
+#include <cstring>
 #include <iostream>
+#include <algorithm>
 
 #include "Graph.hpp"
 #include "Vertex.hpp"
 #include "LinkedList.hpp"
 #include "GraphOrderer.hpp"
+#include "VertexRelabeler.hpp"
+#include "OrderedVertexStream.hpp"
+#include "Stats.hpp"
 
-Graph::Graph(char sortOption)
+Graph::Graph(char sortOption, MonotonicArena* arena)
 {
-    _vertices = new LinkedList<Vertex*>();
+    // The orderer is created first, so an invalid option throws before anything else is allocated
     _orderer = new GraphOrderer(sortOption);
+    _arena = arena;
+    _vertices = new LinkedList<Vertex*>(arena);
+    _orderedVertices = nullptr;
 }
 
 Graph::~Graph()
 {   
-    for(int i = 0; i < _vertices->Length(); i++)
+    for(int i = 0; _arena == nullptr && i < _vertices->Length(); i++)
     {
         delete _vertices->Get(i);
     }
 
     delete _vertices;
+    delete _orderedVertices;
     delete _orderer;
+
+    if (_arena != nullptr)
+        _arena->Reset();
+}
+
+Vertex* Graph::CreateVertex(int id)
+{
+    Vertex* vertex = _arena == nullptr ? new Vertex(id) : _arena->Create<Vertex>(id, _arena);
+    AddVertex(vertex);
+
+    return vertex;
 }
 
 void Graph::AddVertex(Vertex* vertex)
 {
     _vertices->Insert(vertex);
+    InvalidateOrdering();
 }
 
 void Graph::AddEdge(Vertex* origin, Vertex* destiny)
 {
     origin->AddAdjacentVertex(destiny);
+
+    // A vertex that becomes a hub switches to a bitset row, with a threshold that follows the graph size
+    int threshold = AdjacencyIndex::BitsetThreshold(VertexCount());
+    if (origin->GetAdjacentVertices()->Length() >= threshold && !origin->HasDenseAdjacency())
+        origin->ReserveAdjacency(threshold, VertexCount());
 }
 
 LinkedList<Vertex*>* Graph::GetVertices()
@@ -42,20 +68,118 @@ Vertex* Graph::GetVertex(int index)
     return _vertices->Get(index);
 }
 
+GraphOrderer* Graph::GetOrderer()
+{
+    return _orderer;
+}
+
 bool Graph::IsGreedy()
 {
-    for (int i = 0; i < _vertices->Length(); i++)
+    STATS_PHASE("is_greedy");
+
+    std::vector<Vertex*> candidates;
+    if (!PassesPreFilters(candidates))
+        return false;
+
+    // On "no" instances the first vertex checked is usually the one that fails
+    SortByFailureLikelihood(candidates);
+
+    std::vector<int> seen;
+    int stamp = 0;
+
+    for (Vertex* vertex : candidates)
+    {
+        if (!vertex->IsGreedy(seen, stamp++))
+            return false;
+    }
+
+    return true;
+}
+
+bool Graph::PassesPreFilters(std::vector<Vertex*>& candidates)
+{
+    // colorUsed[c] tells if some vertex has the color c
+    std::vector<bool> colorUsed(2, false);
+    int highestColor = 1;
+
+    for (Node<Vertex*>* node = _vertices->Empty() ? nullptr : _vertices->GetNode(0); node != nullptr; node = node->next)
+    {
+        Vertex* vertex = node->data;
+        int color = vertex->GetColor();
+
+        if (color == 1)
+        {
+            colorUsed[1] = true;
+            continue;
+        }
+
+        if (color < 1 || color > vertex->GetAdjacentVertices()->Length() + 1)
+            return false;
+
+        if (color >= (int)colorUsed.size())
+            colorUsed.resize(color + 1, false);
+
+        colorUsed[color] = true;
+        highestColor = std::max(highestColor, color);
+        candidates.push_back(vertex);
+    }
+
+    for (int color = 2; color <= highestColor; color++)
     {
-        if (!_vertices->Get(i)->IsGreedy())
+        if (colorUsed[color] && !colorUsed[color - 1])
             return false;
     }
 
     return true;
 }
 
+void Graph::SortByFailureLikelihood(std::vector<Vertex*>& candidates)
+{
+    // starts[s] is where the vertices with slack s (or more, for the last tier) begin
+    std::vector<size_t> starts(SLACK_TIERS + 1, 0);
+    std::vector<Vertex*> sorted(candidates.size());
+
+    auto tier = [](Vertex* vertex) {
+        return std::min(vertex->GetAdjacentVertices()->Length() + 1 - vertex->GetColor(), SLACK_TIERS - 1);
+    };
+
+    for (Vertex* vertex : candidates)
+        starts[tier(vertex) + 1]++;
+
+    for (int i = 1; i <= SLACK_TIERS; i++)
+        starts[i] += starts[i - 1];
+
+    for (Vertex* vertex : candidates)
+        sorted[starts[tier(vertex)]++] = vertex;
+
+    candidates.swap(sorted);
+}
+
+void Graph::InvalidateOrdering()
+{
+    delete _orderedVertices;
+    _orderedVertices = nullptr;
+}
+
+LinkedList<Vertex*>* Graph::GetOrderedVertices()
+{
+    if (_orderedVertices != nullptr)
+        return _orderedVertices;
+
+    LinkedList<Vertex*>* copy = new LinkedList<Vertex*>(_arena);
+    for (Node<Vertex*>* node = _vertices->Empty() ? nullptr : _vertices->GetNode(0); node != nullptr; node = node->next)
+    {
+        copy->Insert(node->data);
+    }
+
+    _orderedVertices = _orderer->Sort(copy);
+
+    return _orderedVertices;
+}
+
 std::string Graph::OrderedVertices()
 {
-    LinkedList<Vertex*>* orderedVertices = _orderer->Sort(_vertices);
+    LinkedList<Vertex*>* orderedVertices = GetOrderedVertices();
     std::string result = "";
 
     for(int i = 0; i < orderedVertices->Length(); i++)
@@ -69,9 +193,121 @@ std::string Graph::OrderedVertices()
     return result;
 }
 
+std::string Graph::FirstOrderedVertices(int count)
+{
+    if (count <= 0)
+        return "";
+
+    std::string result = "";
+
+    VisitOrderedVertices(count, []() {}, [&](Vertex* vertex) {
+        if (!result.empty())
+            result += " ";
+
+        result += std::to_string(vertex->GetId());
+    });
+
+    return result;
+}
+
+void Graph::VisitOrderedVertices(int count, const std::function<void()>& start, const std::function<void(Vertex*)>& visit)
+{
+    if (count == 0)
+    {
+        start();
+        return;
+    }
+
+    // A method that does not fully sort must sort the whole list, since its first vertices depend on the rest
+    if (count > 0 && _orderedVertices == nullptr && _orderer->IsFullSort())
+    {
+        Vertex** firstVertices = new Vertex*[count < VertexCount() ? count : VertexCount()];
+        int selected = GraphOrderer::SelectFirst(_vertices, count, firstVertices);
+
+        start();
+        for (int i = 0; i < selected; i++)
+        {
+            visit(firstVertices[i]);
+        }
+
+        delete[] firstVertices;
+        return;
+    }
+
+    if (_orderedVertices == nullptr && _orderer->GetOption() == EXTERNAL_ORDERER_OPTION)
+    {
+        STATS_PHASE("sort:e");
+        GraphOrderer::VisitExternalSort(_vertices, start, visit);
+        return;
+    }
+
+    LinkedList<Vertex*>* orderedVertices = GetOrderedVertices();
+    start();
+
+    int i = 0;
+    for (Node<Vertex*>* node = orderedVertices->Empty() ? nullptr : orderedVertices->GetNode(0); 
+         node != nullptr && (count < 0 || i < count); node = node->next, i++)
+    {
+        visit(node->data);
+    }
+}
+
+void Graph::WriteOrderedVertices(OutputWriter& writer, int count, const char* prefix)
+{
+    bool first = true;
+
+    VisitOrderedVertices(count, [&]() {
+        writer.WriteBytes(prefix, strlen(prefix));
+    }, [&](Vertex* vertex) {
+        if (!first)
+            writer.WriteChar(' ');
+
+        writer.WriteInt(vertex->GetId());
+        first = false;
+    });
+}
+
+OrderedVertexStream* Graph::StreamOrderedVertices()
+{
+    return new OrderedVertexStream(_vertices);
+}
+
 void Graph::SetVertexColor(int index, int color)
 {
     _vertices->Get(index)->SetColor(color);
+    InvalidateOrdering();
+}
+
+void Graph::ReplaceColors(const std::vector<int>& colors)
+{
+    int i = 0;
+    for (Node<Vertex*>* node = _vertices->Empty() ? nullptr : _vertices->GetNode(0); node != nullptr; node = node->next, i++)
+    {
+        node->data->ReplaceColor(colors[i]);
+    }
+
+    InvalidateOrdering();
+}
+
+void Graph::Relabel(RelabelOrder order)
+{
+    STATS_PHASE("relabel");
+
+    if (order == RELABEL_NONE)
+        return;
+
+    VertexRelabeler relabeler(_vertices);
+    LinkedList<Vertex*>* vertices = relabeler.Rebuild(relabeler.ComputeOrder(order), _arena);
+
+    for (Node<Vertex*>* node = _arena != nullptr || _vertices->Empty() ? nullptr : _vertices->GetNode(0); node != nullptr; node = node->next)
+    {
+        delete node->data;
+    }
+
+    delete _vertices;
+    _vertices = vertices;
+
+    InvalidateOrdering();
 }
 
 int Graph::VertexCount()
@@ -91,38 +327,74 @@ int Graph::EdgeCount()
     return count / 2;
 }
 
-Graph* Graph::BuildFromIoStream()
+Graph* Graph::BuildFromIoStream(std::istream& input, MonotonicArena* arena)
 {
-    char sortMethod;
-    std::cin >> sortMethod;
-
-    int verticesCount, edgesCount, id, color;
-    std::cin >> verticesCount;
+    STATS_PHASE("parse");
 
-    Graph* graph = new Graph(sortMethod);
+    Graph* graph = BuildTopologyFromIoStream(input, arena);
+    int color = 0;
 
-    for(int i = 0; i < verticesCount; i++)
+    try
+    {
+        for(int i = 0; i < graph->VertexCount(); i++)
+        {
+            input >> color;
+            graph->SetVertexColor(i, color);
+        }
+    }
+    catch(...)
     {
-        graph->AddVertex(new Vertex(i));
+        delete graph;
+        throw;
     }
 
+    return graph;
+}
+
+Graph* Graph::BuildTopologyFromIoStream(std::istream& input, MonotonicArena* arena)
+{
+    char sortMethod = '\0';
+    input >> sortMethod;
+
+    int verticesCount = 0, edgesCount = 0, id = 0;
+    input >> verticesCount;
+
+    Graph* graph = new Graph(sortMethod, arena);
+
+    // The neighbors come in any order, so they are looked up by id here instead of walking the list
+    std::vector<Vertex*> vertices(std::max(verticesCount, 0));
     for(int i = 0; i < verticesCount; i++)
     {
-        std::cin >> edgesCount;
+        vertices[i] = graph->CreateVertex(i);
+    }
+
+    STATS_ADD(STATS_VERTICES_READ, verticesCount);
 
-        Vertex* origin = graph->GetVertex(i);
-        for(int j = 0; j < edgesCount; j++)
+    // A graph left incomplete by an invalid id is freed here, since the caller never receives it
+    try
+    {
+        for(int i = 0; i < verticesCount; i++)
         {
-            std::cin >> id;
-            Vertex* destiny = graph->GetVertex(id);
-            graph->AddEdge(origin, destiny);
+            input >> edgesCount;
+            STATS_ADD(STATS_EDGES_READ, edgesCount);
+
+            Vertex* origin = vertices[i];
+            origin->ReserveAdjacency(edgesCount, verticesCount);
+
+            for(int j = 0; j < edgesCount; j++)
+            {
+                input >> id;
+                if (id < 0 || id >= verticesCount)
+                    throw element_not_found_exception();
+
+                graph->AddEdge(origin, vertices[id]);
+            }
         }
     }
-
-    for(int i = 0; i < verticesCount; i++)
+    catch(...)
     {
-        std::cin >> color;
-        graph->SetVertexColor(i, color);
+        delete graph;
+        throw;
     }
 
     return graph;
@@ -0,0 +1,432 @@
+#include <cmath>
+#include <algorithm>
+
+#include "GraphGenerator.hpp"
+
+GraphGenerator::GraphGenerator(GraphModel model, int vertexCount, double averageDegree, uint64_t seed)
+{
+    if (vertexCount < 1 || averageDegree < 0)
+        throw invalid_graph_model_exception();
+
+    _vertexCount = vertexCount;
+
+    // xorshift never leaves the state zero, so the seed is mixed with an odd constant
+    _state = seed * 0x9E3779B97F4A7C15ULL + 0x2545F4914F6CDD1DULL;
+    if (_state == 0)
+        _state = 1;
+
+    switch (model)
+    {
+        case ERDOS_RENYI:
+        {
+            double probability = vertexCount > 1 ? std::min(1.0, averageDegree / (vertexCount - 1)) : 0;
+            BuildRows([&](const EdgeVisitor& visit) { GenerateUniform(probability, visit); });
+        }
+        break;
+
+        case POWER_LAW:
+        {
+            int edgesPerVertex = std::max(1, (int)std::lround(averageDegree / 2));
+            BuildRows([&](const EdgeVisitor& visit) { GeneratePreferential(edgesPerVertex, visit); });
+        }
+        break;
+
+        case DENSE:
+            BuildRows([&](const EdgeVisitor& visit) { GenerateUniform(DENSE_EDGE_PROBABILITY, visit); });
+        break;
+
+        case GRID:
+        {
+            int radius = std::max(1, (int)std::lround((std::sqrt(averageDegree + 1) - 1) / 2));
+
+            std::vector<int> labels(vertexCount);
+            for (int v = 0; v < vertexCount; v++)
+                labels[v] = v;
+
+            for (int i = vertexCount - 1; i > 0; i--)
+                std::swap(labels[i], labels[NextRandom() % (i + 1)]);
+
+            BuildRows([&](const EdgeVisitor& visit) { GenerateGrid(radius, labels, visit); });
+        }
+        break;
+
+        default:
+            throw invalid_graph_model_exception();
+    }
+
+    ColorGreedily();
+}
+
+uint64_t GraphGenerator::NextRandom()
+{
+    _state ^= _state >> 12;
+    _state ^= _state << 25;
+    _state ^= _state >> 27;
+
+    return _state * 0x2545F4914F6CDD1DULL;
+}
+
+double GraphGenerator::NextUniform()
+{
+    return (NextRandom() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void GraphGenerator::GenerateUniform(double probability, const EdgeVisitor& visit)
+{
+    if (probability <= 0)
+        return;
+
+    if (probability >= 1)
+    {
+        for (int v = 1; v < _vertexCount; v++)
+            for (int w = 0; w < v; w++)
+                visit(v, w);
+
+        return;
+    }
+
+    // Each step jumps over the edges that were not drawn, so the cost is O(V + E) instead of O(V²)
+    double logNotProbability = std::log(1.0 - probability);
+    int64_t v = 1, w = -1;
+
+    while (v < _vertexCount)
+    {
+        w += 1 + (int64_t)std::floor(std::log(1.0 - NextUniform()) / logNotProbability);
+
+        while (w >= v && v < _vertexCount)
+        {
+            w -= v;
+            v++;
+        }
+
+        if (v < _vertexCount)
+            visit((int)v, (int)w);
+    }
+}
+
+void GraphGenerator::GeneratePreferential(int edgesPerVertex, const EdgeVisitor& visit)
+{
+    int initial = std::min(_vertexCount, edgesPerVertex + 1);
+
+    // Every edge appears twice in the endpoints, so a uniform endpoint is a vertex chosen proportionally to its degree
+    std::vector<int> endpoints;
+
+    for (int v = 1; v < initial; v++)
+    {
+        for (int w = 0; w < v; w++)
+        {
+            visit(v, w);
+            endpoints.insert(endpoints.end(), { v, w });
+        }
+    }
+
+    std::vector<int> targets;
+    for (int v = initial; v < _vertexCount; v++)
+    {
+        targets.clear();
+
+        while ((int)targets.size() < edgesPerVertex)
+        {
+            int target = endpoints[NextRandom() % endpoints.size()];
+
+            if (std::find(targets.begin(), targets.end(), target) == targets.end())
+                targets.push_back(target);
+        }
+
+        for (int target : targets)
+        {
+            visit(v, target);
+            endpoints.insert(endpoints.end(), { v, target });
+        }
+    }
+}
+
+void GraphGenerator::GenerateGrid(int radius, const std::vector<int>& labels, const EdgeVisitor& visit)
+{
+    int64_t width = std::max<int64_t>(1, (int64_t)std::ceil(std::sqrt((double)_vertexCount)));
+
+    // Each edge is generated once, from the cell that comes first in row-major order
+    for (int64_t cell = 0; cell < _vertexCount; cell++)
+    {
+        int64_t row = cell / width, column = cell % width;
+
+        for (int64_t otherRow = row; otherRow <= row + radius; otherRow++)
+        {
+            for (int64_t otherColumn = column - radius; otherColumn <= column + radius; otherColumn++)
+            {
+                int64_t other = otherRow * width + otherColumn;
+
+                if (otherColumn < 0 || otherColumn >= width || other <= cell || other >= _vertexCount)
+                    continue;
+
+                visit(labels[cell], labels[other]);
+            }
+        }
+    }
+}
+
+void GraphGenerator::BuildRows(const std::function<void(const EdgeVisitor&)>& generate)
+{
+    // The edges are generated twice from the same state, first to count the degrees and then to fill
+    // the rows, so they never need to be stored as a list besides the rows themselves
+    uint64_t state = _state;
+
+    _offsets.assign(_vertexCount + 1, 0);
+    generate([&](int v, int w) {
+        _offsets[v + 1]++;
+        _offsets[w + 1]++;
+    });
+
+    for (int v = 0; v < _vertexCount; v++)
+        _offsets[v + 1] += _offsets[v];
+
+    _neighbors.resize(_offsets[_vertexCount]);
+    _state = state;
+
+    std::vector<int64_t> next(_offsets.begin(), _offsets.end() - 1);
+    generate([&](int v, int w) {
+        _neighbors[next[v]++] = w;
+        _neighbors[next[w]++] = v;
+    });
+
+    for (int v = 0; v < _vertexCount; v++)
+        std::sort(_neighbors.begin() + _offsets[v], _neighbors.begin() + _offsets[v + 1]);
+}
+
+void GraphGenerator::ColorGreedily()
+{
+    std::vector<int> order(_vertexCount);
+    for (int v = 0; v < _vertexCount; v++)
+        order[v] = v;
+
+    for (int i = _vertexCount - 1; i > 0; i--)
+        std::swap(order[i], order[NextRandom() % (i + 1)]);
+
+    _colors.assign(_vertexCount, UNDEFINED_COLOR);
+
+    // seen[c] holds the last vertex that had a neighbor with color c, so it never needs to be cleared
+    std::vector<int> seen(_vertexCount + 2, -1);
+
+    for (int vertex : order)
+    {
+        for (int64_t i = _offsets[vertex]; i < _offsets[vertex + 1]; i++)
+        {
+            int color = _colors[_neighbors[i]];
+
+            if (color != UNDEFINED_COLOR)
+                seen[color] = vertex;
+        }
+
+        int color = 1;
+        while (seen[color] == vertex)
+            color++;
+
+        _colors[vertex] = color;
+    }
+}
+
+GraphModel GraphGenerator::ParseModel(const std::string& name)
+{
+    if (name == "er")
+        return ERDOS_RENYI;
+
+    if (name == "powerlaw")
+        return POWER_LAW;
+
+    if (name == "dense")
+        return DENSE;
+
+    if (name == "grid")
+        return GRID;
+
+    throw invalid_graph_model_exception();
+}
+
+const char* GraphGenerator::ModelName(GraphModel model)
+{
+    switch (model)
+    {
+        case ERDOS_RENYI:
+            return "er";
+
+        case POWER_LAW:
+            return "powerlaw";
+
+        case DENSE:
+            return "dense";
+
+        case GRID:
+            return "grid";
+    }
+
+    throw invalid_graph_model_exception();
+}
+
+Graph* GraphGenerator::BuildGraph(char sortOption, MonotonicArena* arena)
+{
+    Graph* graph = new Graph(sortOption, arena);
+
+    std::vector<Vertex*> vertices(_vertexCount);
+    for (int v = 0; v < _vertexCount; v++)
+        vertices[v] = graph->CreateVertex(v);
+
+    // The rows have no repeated neighbors, so the adjacency lists are filled without Vertex::IsAdjacent
+    for (int v = 0; v < _vertexCount; v++)
+    {
+        vertices[v]->ReserveAdjacency(_offsets[v + 1] - _offsets[v], _vertexCount);
+
+        for (int64_t i = _offsets[v]; i < _offsets[v + 1]; i++)
+            vertices[v]->AppendAdjacentVertex(vertices[_neighbors[i]]);
+    }
+
+    for (int v = 0; v < _vertexCount; v++)
+        graph->SetVertexColor(v, _colors[v]);
+
+    return graph;
+}
+
+void GraphGenerator::Write(OutputWriter& output, char sortOption)
+{
+    output.WriteChar(sortOption);
+    output.WriteChar('\n');
+    output.WriteInt(_vertexCount);
+    output.WriteChar('\n');
+
+    for (int v = 0; v < _vertexCount; v++)
+    {
+        output.WriteInt(_offsets[v + 1] - _offsets[v]);
+
+        for (int64_t i = _offsets[v]; i < _offsets[v + 1]; i++)
+        {
+            output.WriteChar(' ');
+            output.WriteInt(_neighbors[i]);
+        }
+
+        output.WriteChar('\n');
+    }
+
+    for (int v = 0; v < _vertexCount; v++)
+    {
+        if (v > 0)
+            output.WriteChar(' ');
+
+        output.WriteInt(_colors[v]);
+    }
+
+    output.WriteChar('\n');
+}
+
+int GraphGenerator::BreakGreedy()
+{
+    int vertex = (int)(NextRandom() % _vertexCount);
+    int highest = 0;
+
+    for (int64_t i = _offsets[vertex]; i < _offsets[vertex + 1]; i++)
+        highest = std::max(highest, _colors[_neighbors[i]]);
+
+    // Skipping one color above every neighbor keeps the coloring proper, but leaves a color below it unused
+    _colors[vertex] = highest + 2;
+
+    return vertex;
+}
+
+bool GraphGenerator::IsGreedyColoring()
+{
+    std::vector<int> seen(_vertexCount + 2, -1);
+
+    for (int v = 0; v < _vertexCount; v++)
+    {
+        for (int64_t i = _offsets[v]; i < _offsets[v + 1]; i++)
+        {
+            int color = _colors[_neighbors[i]];
+
+            if (color == _colors[v])
+                return false;
+
+            if (color < _colors[v])
+                seen[color] = v;
+        }
+
+        for (int color = 1; color < _colors[v]; color++)
+        {
+            if (seen[color] != v)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+void GraphGenerator::WriteExpected(OutputWriter& output, char sortOption, int firstCount)
+{
+    bool isGreedy = IsGreedyColoring();
+
+    // A method that does not fully sort gives an order that depends on the list, which only the method
+    // itself reproduces; the edges play no part in it, so a graph with the vertices and colors is enough
+    if (isGreedy && firstCount != 0 && !GraphOrderer(sortOption).IsFullSort())
+    {
+        MonotonicArena arena;
+        Graph* graph = new Graph(sortOption, &arena);
+
+        for (int v = 0; v < _vertexCount; v++)
+            graph->CreateVertex(v);
+
+        graph->ReplaceColors(_colors);
+        graph->WriteOrderedVertices(output, firstCount, "1 ");
+        output.WriteChar('\n');
+
+        delete graph;
+        return;
+    }
+
+    output.WriteInt(isGreedy);
+
+    if (isGreedy && firstCount != 0)
+    {
+        // Counting sort by color: the vertices of each color are visited in increasing order of id,
+        // which is the order of the program (color, then id)
+        std::vector<int64_t> start(_vertexCount + 2, 0);
+        for (int v = 0; v < _vertexCount; v++)
+            start[_colors[v] + 1]++;
+
+        for (int color = 1; color <= _vertexCount; color++)
+            start[color + 1] += start[color];
+
+        std::vector<int> ordered(_vertexCount);
+        for (int v = 0; v < _vertexCount; v++)
+            ordered[start[_colors[v]]++] = v;
+
+        int count = firstCount < 0 ? _vertexCount : std::min(firstCount, _vertexCount);
+
+        output.WriteChar(' ');
+        for (int i = 0; i < count; i++)
+        {
+            if (i > 0)
+                output.WriteChar(' ');
+
+            output.WriteInt(ordered[i]);
+        }
+    }
+
+    output.WriteChar('\n');
+}
+
+int GraphGenerator::VertexCount()
+{
+    return _vertexCount;
+}
+
+int64_t GraphGenerator::EdgeCount()
+{
+    return (int64_t)_neighbors.size() / 2;
+}
+
+int GraphGenerator::ColorCount()
+{
+    return _vertexCount == 0 ? 0 : *std::max_element(_colors.begin(), _colors.end());
+}
+
+int GraphGenerator::GetColor(int vertex)
+{
+    return _colors.at(vertex);
+}
@@ -2,333 +2,353 @@
 #include "Vertex.hpp"
 #include "LinkedList.hpp"
 #include "GraphOrderer.hpp"
+#include "PackedKeySorter.hpp"
+#include "ExternalSorter.hpp"
+#include "OrdererEngine.hpp"
+#include "Stats.hpp"
+
+size_t GraphOrderer::_externalMemoryBudget = DEFAULT_EXTERNAL_MEMORY_BUDGET;
 
 GraphOrderer::GraphOrderer(char option)
 {
+    if (option != AUTO_ORDERER_OPTION && std::string(SORT_OPTIONS).find(option) == std::string::npos)
+        throw invalid_orderer_option_exception();
+
     _option = option;
-    SelectSortMethod(option);
+    _chosenOption = option;
 }
 
-void GraphOrderer::SelectSortMethod(char option)
+LinkedList<Vertex*>* GraphOrderer::SortWith(char option, LinkedList<Vertex*>* list)
 {
     switch (option)
     {
         case 'b':
-            _ordererMethod = &BubbleSort;
-        break;
+            return BubbleSort(list);
         case 's':
-            _ordererMethod = &SelectionSort;
-        break;
+            return SelectionSort(list);
         case 'i':
-            _ordererMethod = &InsertionSort;
-        break;
+            return InsertionSort(list);
         case 'q':
-            _ordererMethod = &QuickSort;
-        break;
+            return QuickSort(list);
         case 'm':
-            _ordererMethod = &MergeSort;
-        break;
+            return MergeSort(list);
         case 'p':
-            _ordererMethod = &HeapSort;
-        break;
+            return HeapSort(list);
         case 'y':
-            _ordererMethod = &CustomSort;
-        break;
+            return CustomSort(list);
+        case 'l':
+            return LinkedMergeSort(list);
+        case 'v':
+            return PackedKeySort(list);
+        case 'n':
+            return IntroSort(list);
+        case 't':
+            return TimSort(list);
+        case 'e':
+            return ExternalSort(list);
         default:
             throw invalid_orderer_option_exception();
-        break;
     }
 }
 
 LinkedList<Vertex*>* GraphOrderer::Sort(LinkedList<Vertex*>* list)
 {
-    return _ordererMethod(list);
+    if (_option == AUTO_ORDERER_OPTION)
+        ChooseSortMethod(list);
+
+    STATS_PHASE(std::string("sort:") + _chosenOption);
+
+    return SortWith(_chosenOption, list);
 }
 
-LinkedList<Vertex*>* GraphOrderer::BubbleSort(LinkedList<Vertex*>* list)
+char GraphOrderer::GetOption()
 {
-    bool swapped;
+    return _option;
+}
 
-    for (int i = 0; i < list->Length() - 1; i++) 
-    {
-        swapped = false;
-        for (int j = 0; j < list->Length() - i - 1; j++) 
-        {
-            auto vertex1 = list->GetNode(j);
-            auto vertex2 = list->GetNode(j + 1);
-
-            if (vertex1->data->IsBiggerThan(vertex2->data)) 
-            {
-                list->InvertNodeContent(vertex1, vertex2);
-                swapped = true;
-            }
-        }
- 
-        if (swapped == false)
-            break;
-    }
+bool GraphOrderer::IsFullSort()
+{
+    // The automatic option only chooses among full sorts
+    return std::string(PARTIAL_SORT_OPTIONS).find(_option) == std::string::npos;
+}
 
-    return list;
+char GraphOrderer::GetChosenOption()
+{
+    return _chosenOption;
 }
 
-LinkedList<Vertex*>* GraphOrderer::SelectionSort(LinkedList<Vertex*>* list)
+std::string GraphOrderer::GetChoiceReason()
 {
-    Node<Vertex*>* min = nullptr;
+    return _choiceReason;
+}
 
-    for (int i = 0; i < (list->Length() - 1); i++)
+#define AUTO_SMALL_LIST (16)
+#define AUTO_PACKED_KEY_MIN_LENGTH (1024)
+#define AUTO_NEARLY_SORTED_RUN_RATIO (64)
+
+void GraphOrderer::ChooseSortMethod(LinkedList<Vertex*>* list)
+{
+    int length = list->Length();
+
+    int runs = length > 0 ? 1 : 0;
+    int minId = 0, maxId = 0;
+    Vertex* previous = nullptr;
+
+    for (Node<Vertex*>* node = list->Empty() ? nullptr : list->GetNode(0); node != nullptr; node = node->next)
     {
-        Node<Vertex*>* current = list->GetNode(i);
-        min = current;
+        Vertex* current = node->data;
 
-        for (int j = i; j < list->Length(); j++)
+        if (previous == nullptr)
         {
-            Node<Vertex*>* current_j = list->GetNode(j);
-            if (current_j->data->IsLessThan(min->data))
-                min = current_j;
+            minId = maxId = current->GetId();
+        }
+        else
+        {
+            if (previous->IsBiggerThan(current))
+                runs++;
+
+            minId = current->GetId() < minId ? current->GetId() : minId;
+            maxId = current->GetId() > maxId ? current->GetId() : maxId;
         }
 
-        list->InvertNodeContent(current, min);
+        previous = current;
     }
 
-    return list;
+    bool denseIds = minId >= 0 && (long long)maxId - minId + 1 <= 4LL * length;
+
+    std::string characteristics = std::to_string(length) + " vertices, " + std::to_string(runs) + " ascending runs";
+
+    if (length <= AUTO_SMALL_LIST)
+    {
+        _chosenOption = 'i';
+        _choiceReason = "InsertionSort ('i'): small list (" + characteristics + ")";
+    }
+    else if (runs <= 1 + length / AUTO_NEARLY_SORTED_RUN_RATIO)
+    {
+        _chosenOption = 't';
+        _choiceReason = "TimSort ('t'): nearly sorted list (" + characteristics + ")";
+    }
+    else if (length >= AUTO_PACKED_KEY_MIN_LENGTH && denseIds && PackedKeySorter::HasAvx2())
+    {
+        _chosenOption = 'v';
+        _choiceReason = "PackedKeySort ('v'): large unsorted list with dense ids and AVX2 (" + characteristics + ")";
+    }
+    else
+    {
+        _chosenOption = 'n';
+        _choiceReason = "IntroSort ('n'): unsorted list (" + characteristics + ")";
+    }
 }
 
-LinkedList<Vertex*>* GraphOrderer::InsertionSort(LinkedList<Vertex*>* list)
+/**
+ * Engine instantiations: on the vertices themselves, and on vertices with their keys computed in advance,
+ * used by the sorts that compare each vertex many times.
+ */
+typedef OrdererEngine<Vertex*, VertexKey> VertexOrdererEngine;
+typedef OrdererEngine<KeyedVertex, StoredKey> KeyedOrdererEngine;
+
+Vertex** ListToArray(LinkedList<Vertex*>* list)
 {
-    Vertex* aux = nullptr;
+    Vertex** array = new Vertex*[list->Length()];
 
-    for(int i = 0; i < list->Length(); i++)
+    int i = 0;
+    for (Node<Vertex*>* node = list->Empty() ? nullptr : list->GetNode(0); node != nullptr; node = node->next)
     {
-        aux = list->Get(i);
-        
-        int j = i - 1;
-        while((j >= 0) && aux->IsLessThan(list->GetNode(j)->data))
-        {
-            list->InvertNodeContent(list->GetNode(j+1), list->GetNode(j));
-            j--;
-        }
-        list->SetNodeContent(list->GetNode(j+1), aux);
+        array[i++] = node->data;
     }
 
-    return list;
+    return array;
 }
 
-int QuickSortPartition(LinkedList<Vertex*>* list, int start, int end)
+void ArrayToList(Vertex** array, LinkedList<Vertex*>* list)
 {
-    auto pivot = list->Get(start);
- 
-    int count = 0;
-    for (int i = start + 1; i <= end; i++) 
+    int i = 0;
+    for (Node<Vertex*>* node = list->Empty() ? nullptr : list->GetNode(0); node != nullptr; node = node->next)
     {
-        auto current = list->Get(i);
-        if (current->IsLessThanOrEqual(pivot))
-            count++;
+        list->SetNodeContent(node, array[i++]);
     }
- 
-    int pivotIndex = start + count;
-    auto toChange_1 = list->GetNode(pivotIndex);
-    auto toChange_2 = list->GetNode(start);
-
-    list->InvertNodeContent(toChange_1, toChange_2);
- 
-    int i = start, j = end;
- 
-    while (i < pivotIndex && j > pivotIndex) 
-    {
- 
-        while (list->Get(i)->IsLessThanOrEqual(pivot)) 
-        {
-            i++;
-        }
- 
-        while (list->Get(j)->IsBiggerThan(pivot)) 
-        {
-            j--;
-        }
- 
-        if (i < pivotIndex && j > pivotIndex) 
-        {
-            auto i_index = i++;
-            auto j_index = j--;
+}
 
-            toChange_1 = list->GetNode(i_index);
-            toChange_2 = list->GetNode(j_index);
+/**
+ * Applies a sort of the engine to a copy of the list in an array, which is written back to the same nodes.
+ */
+template <void (*SortArray)(KeyedVertex*, int)>
+LinkedList<Vertex*>* SortAsArray(LinkedList<Vertex*>* list)
+{
+    if (list->Length() < 2)
+        return list;
 
-            list->InvertNodeContent(toChange_1, toChange_2);
-        }
-    }
- 
-    return pivotIndex;
+    KeyedVertex* array = new KeyedVertex[list->Length()];
+    VertexKey keyOf;
+
+    int i = 0;
+    for (Node<Vertex*>* node = list->GetNode(0); node != nullptr; node = node->next)
+        array[i++] = { keyOf(node->data), node->data };
+
+    SortArray(array, list->Length());
+
+    i = 0;
+    for (Node<Vertex*>* node = list->GetNode(0); node != nullptr; node = node->next)
+        list->SetNodeContent(node, array[i++].vertex);
+
+    delete[] array;
+
+    return list;
 }
 
-void QuickSortRecursive(LinkedList<Vertex*>* list, int start, int end)
+LinkedList<Vertex*>* GraphOrderer::BubbleSort(LinkedList<Vertex*>* list)
 {
-    if (start >= end)
-        return;
+    return SortAsArray<&KeyedOrdererEngine::BubbleSort>(list);
+}
 
-    int pivotIndex = QuickSortPartition(list, start, end);
+LinkedList<Vertex*>* GraphOrderer::SelectionSort(LinkedList<Vertex*>* list)
+{
+    return SortAsArray<&KeyedOrdererEngine::SelectionSort>(list);
+}
 
-    QuickSortRecursive(list, start, pivotIndex - 1);
-    QuickSortRecursive(list, pivotIndex + 1, end);
+LinkedList<Vertex*>* GraphOrderer::InsertionSort(LinkedList<Vertex*>* list)
+{
+    return SortAsArray<&KeyedOrdererEngine::InsertionSort>(list);
 }
 
 LinkedList<Vertex*>* GraphOrderer::QuickSort(LinkedList<Vertex*>* list)
 {
-    QuickSortRecursive(list, 0, list->Length() - 1);
-    return list;
+    return SortAsArray<&KeyedOrdererEngine::QuickSort>(list);
 }
 
-void Merge(LinkedList<Vertex*>* list, int left, int mid, int right)
+LinkedList<Vertex*>* GraphOrderer::MergeSort(LinkedList<Vertex*>* list)
 {
-    int subArrayOne = mid - left + 1;
-    int subArrayTwo = right - mid;
- 
-    Vertex** leftArray = new Vertex*[subArrayOne];
-    Vertex** rightArray = new Vertex*[subArrayTwo];
- 
-    for (int i = 0; i < subArrayOne; i++)
-    {
-        leftArray[i] = list->Get(left + i);
-    }
-        
-        
-    for (int j = 0; j < subArrayTwo; j++)
-    {
-        rightArray[j] = list->Get(mid + 1 + j);
-    }
-        
-    int indexOfSubArrayOne = 0;
-    int indexOfSubArrayTwo = 0;
-    int indexOfMergedArray = left;
- 
-    while (indexOfSubArrayOne < subArrayOne && indexOfSubArrayTwo < subArrayTwo)
-    {
-        if (leftArray[indexOfSubArrayOne]->IsLessThanOrEqual(rightArray[indexOfSubArrayTwo])) 
-        {
-            list->SetNodeContent(list->GetNode(indexOfMergedArray), leftArray[indexOfSubArrayOne]);
-            indexOfSubArrayOne++;
-        }
-        else 
-        {
-            list->SetNodeContent(list->GetNode(indexOfMergedArray), rightArray[indexOfSubArrayTwo]);
-            indexOfSubArrayTwo++;
-        }
-        indexOfMergedArray++;
-    }
- 
-    while (indexOfSubArrayOne < subArrayOne) 
-    {
-        list->SetNodeContent(list->GetNode(indexOfMergedArray), leftArray[indexOfSubArrayOne]);
-        indexOfSubArrayOne++;
-        indexOfMergedArray++;
-    }
- 
-    while (indexOfSubArrayTwo < subArrayTwo) 
-    {
-        list->SetNodeContent(list->GetNode(indexOfMergedArray), rightArray[indexOfSubArrayTwo]);
-        indexOfSubArrayTwo++;
-        indexOfMergedArray++;
-    }
+    return SortAsArray<&KeyedOrdererEngine::MergeSort>(list);
+}
 
-    delete[] leftArray;
-    delete[] rightArray;
+LinkedList<Vertex*>* GraphOrderer::HeapSort(LinkedList<Vertex*>* list)
+{
+    return SortAsArray<&KeyedOrdererEngine::HeapSort>(list);
 }
 
-void MergeSortRecursive(LinkedList<Vertex*>* list, int const begin, int const end)
+LinkedList<Vertex*>* GraphOrderer::CustomSort(LinkedList<Vertex*>* list)
 {
-    if (begin >= end)
-        return;
- 
-    int mid = begin + (end - begin) / 2;
+    return SortAsArray<&KeyedOrdererEngine::CustomSort>(list);
+}
 
-    MergeSortRecursive(list, begin, mid);
-    MergeSortRecursive(list, mid + 1, end);
+LinkedList<Vertex*>* GraphOrderer::IntroSort(LinkedList<Vertex*>* list)
+{
+    return SortAsArray<&KeyedOrdererEngine::IntroSort>(list);
+}
 
-    Merge(list, begin, mid, end);
+LinkedList<Vertex*>* GraphOrderer::TimSort(LinkedList<Vertex*>* list)
+{
+    return SortAsArray<&KeyedOrdererEngine::TimSort>(list);
 }
 
-LinkedList<Vertex*>* GraphOrderer::MergeSort(LinkedList<Vertex*>* list)
+LinkedList<Vertex*>* GraphOrderer::LinkedMergeSort(LinkedList<Vertex*>* list)
 {
-    MergeSortRecursive(list, 0, list->Length() - 1);
+    list->SortNodes(&VertexOrdererEngine::IsLessThanOrEqual);
     return list;
 }
 
-void Heapify(LinkedList<Vertex*>* list, int n, int i)
+LinkedList<Vertex*>* GraphOrderer::PackedKeySort(LinkedList<Vertex*>* list)
 {
-    int largest = i;
-    int l = 2 * i + 1;
-    int r = 2 * i + 2;
- 
-    if (l < n && list->Get(l)->IsBiggerThan(list->Get(largest)))
-        largest = l;
- 
-    if (r < n && list->Get(r)->IsBiggerThan(list->Get(largest)))
-        largest = r;
- 
-    if (largest != i) 
-    {
-        auto firstNode = list->GetNode(i);
-        auto secondNode = list->GetNode(largest);
+    int length = list->Length();
+    if (length < 2)
+        return list;
 
-        list->InvertNodeContent(firstNode, secondNode);
+    Node<Vertex*>* first = list->GetNode(0);
 
-        Heapify(list, n, largest);
+    int minId = first->data->GetId();
+    int maxId = minId;
+    for (Node<Vertex*>* node = first; node != nullptr; node = node->next)
+    {
+        int id = node->data->GetId();
+        minId = id < minId ? id : minId;
+        maxId = id > maxId ? id : maxId;
     }
-}
 
-LinkedList<Vertex*>* GraphOrderer::HeapSort(LinkedList<Vertex*>* list)
-{
-    for (int i = list->Length() / 2 - 1; i >= 0; i--)
-        Heapify(list, list->Length(), i);
- 
-    for (int i = list->Length() - 1; i >= 0; i--) 
+    long long idRange = (long long)maxId - minId + 1;
+    if (minId < 0 || idRange > 4LL * length)
+        return LinkedMergeSort(list);
+
+    long long* keys = new long long[length];
+    Vertex** vertexById = new Vertex*[idRange];
+
+    int i = 0;
+    for (Node<Vertex*>* node = first; node != nullptr; node = node->next)
     {
-        auto firstNode = list->GetNode(0);
-        auto secondNode = list->GetNode(i);
+        keys[i++] = PackedKeySorter::Pack(node->data);
+        vertexById[node->data->GetId() - minId] = node->data;
+    }
 
-        list->InvertNodeContent(firstNode, secondNode);
- 
-        Heapify(list, i, 0);
+    PackedKeySorter::Sort(keys, length);
+
+    i = 0;
+    for (Node<Vertex*>* node = first; node != nullptr; node = node->next)
+    {
+        list->SetNodeContent(node, vertexById[PackedKeySorter::UnpackId(keys[i++]) - minId]);
     }
 
+    delete[] keys;
+    delete[] vertexById;
+
     return list;
 }
 
-LinkedList<Vertex*>* GraphOrderer::CustomSort(LinkedList<Vertex*>* list)
+int GraphOrderer::SelectFirst(LinkedList<Vertex*>* list, int count, Vertex** result)
 {
-    LinkedList<int>* fixedIndexes = new LinkedList<int>();
+    STATS_PHASE("select_first");
 
-    int currentIndex = 0;
-    while(fixedIndexes->Length() < list->Length())
-    {
-        if (fixedIndexes->Contains(currentIndex))
-        {
-            currentIndex++;
-            continue;
-        }
+    int length = list->Length();
+    if (count > length)
+        count = length;
 
-        auto currentNode = list->GetNode(currentIndex);
+    if (count <= 0)
+        return 0;
 
-        int biggerThan = 0;
-        for(int i = 0; i < list->Length(); i++)
-        {
-            if (currentNode->data->IsBiggerThan(list->Get(i)))
-                biggerThan++;
-        }
+    Vertex** array = ListToArray(list);
+    VertexOrdererEngine::SelectFirst(array, length, count);
 
-        int destinyIndex = biggerThan;
-        if (currentIndex != destinyIndex)
-        {
-            auto destinyNode = list->GetNode(destinyIndex);
-            list->InvertNodeContent(currentNode, destinyNode);
-        }
-        
-        fixedIndexes->Insert(currentIndex);
+    for (int i = 0; i < count; i++)
+        result[i] = array[i];
+
+    delete[] array;
+
+    return count;
+}
+
+void GraphOrderer::SetExternalMemoryBudget(size_t bytes)
+{
+    _externalMemoryBudget = bytes;
+}
 
-        currentIndex++;
+void GraphOrderer::VisitExternalSort(LinkedList<Vertex*>* list, const std::function<void()>& start, const std::function<void(Vertex*)>& visit)
+{
+    ExternalSorter sorter(_externalMemoryBudget);
+
+    for (Node<Vertex*>* node = list->Empty() ? nullptr : list->GetNode(0); node != nullptr; node = node->next)
+    {
+        sorter.Add({ node->data->GetColor(), node->data->GetId(), node->data });
     }
 
-    delete fixedIndexes;
+    sorter.Finish();
+    start();
+
+    SortRecord record;
+    while (sorter.Next(record))
+    {
+        visit(record.vertex);
+    }
+}
+
+LinkedList<Vertex*>* GraphOrderer::ExternalSort(LinkedList<Vertex*>* list)
+{
+    if (list->Length() < 2)
+        return list;
+
+    // Every vertex is in a record before the first visit, so the nodes can be overwritten in order
+    Node<Vertex*>* node = list->GetNode(0);
+    VisitExternalSort(list, []() {}, [&](Vertex* vertex) {
+        list->SetNodeContent(node, vertex);
+        node = node->next;
+    });
 
     return list;
-}
\ No newline at end of file
+}
@@ -0,0 +1,209 @@
+#include <chrono>
+#include <thread>
+#include <cstring>
+
+#include "GraphPipeline.hpp"
+#include "GraphRunner.hpp"
+
+#define SPINS_BEFORE_SLEEP (64)
+#define MAX_SLEEP_MICROSECONDS (1000)
+
+/**
+ * Waits before the next attempt on a full or empty queue: yields at first and then sleeps for
+ * growing periods, so a stage blocked on a slow input does not keep a core busy.
+ */
+void WaitForQueue(int& attempts)
+{
+    if (attempts < SPINS_BEFORE_SLEEP)
+    {
+        attempts++;
+        std::this_thread::yield();
+        return;
+    }
+
+    int microseconds = 1 << (attempts - SPINS_BEFORE_SLEEP);
+    if (microseconds < MAX_SLEEP_MICROSECONDS)
+        attempts++;
+
+    std::this_thread::sleep_for(std::chrono::microseconds(microseconds));
+}
+
+GraphPipeline::GraphPipeline(std::istream& input, OutputWriter& output, int firstCount, size_t depth)
+    : _input(input), _output(output), _parsed(depth), _verified(depth)
+{
+    _firstCount = firstCount;
+    _cancelled = false;
+}
+
+bool GraphPipeline::Push(SpscQueue<PipelineItem>& queue, const PipelineItem& item)
+{
+    int attempts = 0;
+
+    while (!queue.TryPush(item))
+    {
+        if (_cancelled)
+            return false;
+
+        WaitForQueue(attempts);
+    }
+
+    return true;
+}
+
+bool GraphPipeline::Pop(SpscQueue<PipelineItem>& queue, PipelineItem& item)
+{
+    int attempts = 0;
+
+    while (!queue.TryPop(item))
+    {
+        if (_cancelled)
+            return false;
+
+        WaitForQueue(attempts);
+    }
+
+    return true;
+}
+
+void GraphPipeline::ParseStage()
+{
+    while (!_cancelled)
+    {
+        _input >> std::ws;
+        if (_input.peek() == std::istream::traits_type::eof())
+            break;
+
+        PipelineItem item = { nullptr, false, nullptr };
+
+        try
+        {
+            item.graph = GraphRunner::Build(_input);
+        }
+        catch(...)
+        {
+            item.error = GraphRunner::DescribeCurrentException();
+        }
+
+        if (!Push(_parsed, item))
+        {
+            delete item.graph;
+            return;
+        }
+
+        if (item.error != nullptr)
+            break;
+    }
+
+    Push(_parsed, { nullptr, false, nullptr });
+}
+
+void GraphPipeline::VerifyStage()
+{
+    PipelineItem item;
+
+    while (Pop(_parsed, item))
+    {
+        if (item.graph != nullptr)
+        {
+            try
+            {
+                item.isGreedy = item.graph->IsGreedy();
+
+                // The first vertices alone are selected by the output stage, without sorting everything
+                if (item.isGreedy && _firstCount < 0)
+                    item.graph->GetOrderedVertices();
+            }
+            catch(...)
+            {
+                delete item.graph;
+                item.graph = nullptr;
+                item.error = GraphRunner::DescribeCurrentException();
+            }
+        }
+
+        bool last = item.graph == nullptr && item.error == nullptr;
+
+        if (!Push(_verified, item))
+        {
+            delete item.graph;
+            return;
+        }
+
+        if (last)
+            return;
+    }
+}
+
+long GraphPipeline::OutputStage()
+{
+    long answers = 0;
+    PipelineItem item;
+
+    while (Pop(_verified, item) && (item.graph != nullptr || item.error != nullptr))
+    {
+        if (item.graph != nullptr)
+        {
+            try
+            {
+                GraphRunner::WriteAnswer(item.graph, item.isGreedy, _output, _firstCount);
+            }
+            catch(...)
+            {
+                delete item.graph;
+                throw;
+            }
+
+            delete item.graph;
+        }
+        else
+        {
+            _output.WriteBytes(item.error, strlen(item.error));
+            _output.WriteChar('\n');
+        }
+
+        answers++;
+
+        // Answers already computed go out together, the output is only sent when the stage would wait
+        if (_verified.Empty())
+            _output.Flush();
+    }
+
+    _output.Flush();
+
+    return answers;
+}
+
+long GraphPipeline::Run()
+{
+    _cancelled = false;
+
+    std::thread parser(&GraphPipeline::ParseStage, this);
+    std::thread verifier(&GraphPipeline::VerifyStage, this);
+
+    long answers = 0;
+
+    try
+    {
+        answers = OutputStage();
+    }
+    catch(...)
+    {
+        _cancelled = true;
+
+        parser.join();
+        verifier.join();
+
+        PipelineItem item;
+        while (_parsed.TryPop(item))
+            delete item.graph;
+        while (_verified.TryPop(item))
+            delete item.graph;
+
+        throw;
+    }
+
+    parser.join();
+    verifier.join();
+
+    return answers;
+}
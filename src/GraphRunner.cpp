@@ -0,0 +1,103 @@
+#include <cstring>
+
+#include "Graph.hpp"
+#include "GraphRunner.hpp"
+#include "ExternalSorter.hpp"
+#include "StreamingVerifier.hpp"
+#include "Stats.hpp"
+
+bool GraphRunner::Run(std::istream& input, OutputWriter& output, int firstCount, MonotonicArena* arena)
+{
+    Graph* graph = nullptr;
+
+    try
+    {
+        graph = Build(input, arena);
+        WriteAnswer(graph, graph->IsGreedy(), output, firstCount);
+
+        delete graph;
+        return true;
+    }
+    catch(output_write_exception)
+    {
+        delete graph;
+        throw;
+    }
+    catch(...)
+    {
+        const char* message = DescribeCurrentException();
+
+        output.WriteBytes(message, strlen(message));
+        output.WriteChar('\n');
+
+        // A graph whose construction failed was already freed while it was built, with its part of the arena
+        delete graph;
+        return false;
+    }
+}
+
+Graph* GraphRunner::Build(std::istream& input, MonotonicArena* arena)
+{
+    Graph* graph = Graph::BuildFromIoStream(input, arena);
+
+    if (input.fail())
+    {
+        delete graph;
+        throw malformed_input_exception();
+    }
+
+    return graph;
+}
+
+void GraphRunner::WriteAnswer(Graph* graph, bool isGreedy, OutputWriter& output, int firstCount)
+{
+    STATS_PHASE("output");
+
+    // The verdict is only written once the vertices are sorted, so a sort that fails writes nothing
+    if (isGreedy && firstCount != 0)
+        graph->WriteOrderedVertices(output, firstCount, "1 ");
+    else
+        output.WriteInt(isGreedy);
+
+    output.WriteChar('\n');
+}
+
+const char* GraphRunner::DescribeCurrentException()
+{
+    try
+    {
+        throw;
+    }
+    catch(malformed_input_exception)
+    {
+        return "A entrada terminou antes do grafo estar completo ou possui dados inválidos!";
+    }
+    catch(element_not_found_exception)
+    {
+        return "Houve uma tentativa inválida de acesso a um item da lista encadeada!";
+    }
+    catch(invalid_orderer_option_exception)
+    {
+        return "O método de ordenação escolhido é inválido!";
+    }
+    catch(unavailable_color_exception)
+    {
+        return "Coloração indisponível. Houve uma tentativa de atribuir uma cor indisponível a um vértice!";
+    }
+    catch(invalid_color_change_exception)
+    {
+        return "Coloração inválida. Houve uma tentativa de atribuir uma cor fora do padrão a um vértice!";
+    }
+    catch(external_storage_exception)
+    {
+        return "Não foi possível usar os arquivos temporários da ordenação externa!";
+    }
+    catch(unseekable_input_exception)
+    {
+        return "A entrada não pode ser lida novamente na verificação em duas passagens!";
+    }
+    catch(...)
+    {
+        return "Houve um erro não identificado!";
+    }
+}
@@ -0,0 +1,260 @@
+#include <cmath>
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <istream>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/socket.h>
+
+#include "GraphServer.hpp"
+#include "GraphRunner.hpp"
+#include "OutputWriter.hpp"
+#include "FileDescriptorStream.hpp"
+
+#define LISTEN_BACKLOG (128)
+
+GraphServer::GraphServer(const char* socketPath, int workerCount, int firstCount)
+{
+    _socketPath = socketPath;
+    _workerCount = workerCount < 1 ? 1 : workerCount;
+    _firstCount = firstCount;
+    _listener = -1;
+    _running = false;
+
+    std::fill(_latencyBuckets, _latencyBuckets + LATENCY_BUCKET_COUNT, 0);
+    _requestCount = 0;
+    _maxLatency = 0;
+}
+
+GraphServer::~GraphServer()
+{
+    Stop();
+}
+
+void GraphServer::Start()
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (_socketPath.size() >= sizeof(address.sun_path))
+        throw server_socket_exception();
+
+    strcpy(address.sun_path, _socketPath.c_str());
+
+    _listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_listener < 0)
+        throw server_socket_exception();
+
+    unlink(_socketPath.c_str());
+
+    if (bind(_listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(_listener, LISTEN_BACKLOG) != 0)
+    {
+        close(_listener);
+        _listener = -1;
+        throw server_socket_exception();
+    }
+
+    // A client that disconnects early must not end the server
+    signal(SIGPIPE, SIG_IGN);
+
+    _running = true;
+    _acceptor = std::thread(&GraphServer::AcceptLoop, this);
+
+    for (int i = 0; i < _workerCount; i++)
+    {
+        _workers.emplace_back(&GraphServer::WorkerLoop, this);
+    }
+}
+
+void GraphServer::Stop()
+{
+    if (!_running.exchange(false))
+        return;
+
+    shutdown(_listener, SHUT_RDWR);
+
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+
+        for (int connection : _activeConnections)
+            shutdown(connection, SHUT_RDWR);
+    }
+    _connectionsSignal.notify_all();
+
+    _acceptor.join();
+    for (std::thread& worker : _workers)
+        worker.join();
+    _workers.clear();
+
+    for (int connection : _pendingConnections)
+        close(connection);
+    _pendingConnections.clear();
+
+    close(_listener);
+    _listener = -1;
+    unlink(_socketPath.c_str());
+}
+
+void GraphServer::AcceptLoop()
+{
+    while (_running)
+    {
+        int connection = accept(_listener, nullptr, nullptr);
+
+        if (connection < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_connectionsMutex);
+
+            if (!_running)
+            {
+                close(connection);
+                return;
+            }
+
+            _pendingConnections.push_back(connection);
+        }
+        _connectionsSignal.notify_one();
+    }
+}
+
+int GraphServer::NextConnection()
+{
+    std::unique_lock<std::mutex> lock(_connectionsMutex);
+    _connectionsSignal.wait(lock, [this] { return !_running || !_pendingConnections.empty(); });
+
+    if (!_running)
+        return -1;
+
+    int connection = _pendingConnections.front();
+    _pendingConnections.pop_front();
+    _activeConnections.push_back(connection);
+
+    return connection;
+}
+
+void GraphServer::WorkerLoop()
+{
+    // Buffers reused by every connection served by this worker
+    FileDescriptorStreamBuffer inputBuffer(-1);
+    std::istream input(&inputBuffer);
+    OutputWriter output(-1);
+    MonotonicArena arena;
+
+    int connection;
+    while ((connection = NextConnection()) >= 0)
+    {
+        inputBuffer.Reset(connection);
+        input.clear();
+        output.Redirect(connection);
+
+        try
+        {
+            ServeConnection(input, output, arena);
+        }
+        catch(output_write_exception)
+        {}
+
+        {
+            std::lock_guard<std::mutex> lock(_connectionsMutex);
+            _activeConnections.erase(std::find(_activeConnections.begin(), _activeConnections.end(), connection));
+        }
+
+        close(connection);
+    }
+}
+
+void GraphServer::ServeConnection(std::istream& input, OutputWriter& output, MonotonicArena& arena)
+{
+    while (_running)
+    {
+        input >> std::ws;
+        if (input.peek() == std::istream::traits_type::eof())
+            return;
+
+        if (input.peek() == '#')
+        {
+            std::string command;
+            std::getline(input, command);
+
+            if (command == STATS_COMMAND)
+            {
+                std::string stats = "requests " + std::to_string(RequestCount()) +
+                    " p50 " + std::to_string((long long)LatencyPercentile(50)) +
+                    " p90 " + std::to_string((long long)LatencyPercentile(90)) +
+                    " p99 " + std::to_string((long long)LatencyPercentile(99)) +
+                    " max " + std::to_string((long long)LatencyPercentile(100)) + "\n";
+
+                output.WriteBytes(stats.c_str(), stats.size());
+            }
+            else
+            {
+                const char* message = "Comando desconhecido!\n";
+                output.WriteBytes(message, strlen(message));
+            }
+
+            output.Flush();
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        bool processed = GraphRunner::Run(input, output, _firstCount, &arena);
+
+        // Recorded before the answer is sent, so a client that received it also sees it in the statistics
+        auto end = std::chrono::steady_clock::now();
+        RecordLatency(std::chrono::duration<double, std::micro>(end - start).count());
+
+        output.Flush();
+
+        // After an error the position in the stream is unknown, so the connection is closed
+        if (!processed)
+            return;
+    }
+}
+
+void GraphServer::RecordLatency(double microseconds)
+{
+    // Bucket 0 holds latencies below 1 µs, and bucket i > 0 the ones up to 2^(i / LATENCY_BUCKETS_PER_DOUBLING)
+    int bucket = microseconds < 1 ? 0 : 1 + (int)(std::log2(microseconds) * LATENCY_BUCKETS_PER_DOUBLING);
+    bucket = bucket < LATENCY_BUCKET_COUNT ? bucket : LATENCY_BUCKET_COUNT - 1;
+
+    std::lock_guard<std::mutex> lock(_latenciesMutex);
+    _latencyBuckets[bucket]++;
+    _requestCount++;
+    _maxLatency = std::max(_maxLatency, microseconds);
+}
+
+long GraphServer::RequestCount()
+{
+    std::lock_guard<std::mutex> lock(_latenciesMutex);
+    return _requestCount;
+}
+
+double GraphServer::LatencyPercentile(double percentile)
+{
+    std::lock_guard<std::mutex> lock(_latenciesMutex);
+
+    if (_requestCount == 0)
+        return 0;
+
+    percentile = percentile < 0 ? 0 : (percentile > 100 ? 100 : percentile);
+    long rank = (long)((percentile / 100.0) * (_requestCount - 1) + 0.5);
+
+    int bucket = 0;
+    for (long seen = _latencyBuckets[0]; seen <= rank; seen += _latencyBuckets[bucket])
+        bucket++;
+
+    double bound = std::pow(2.0, (double)bucket / LATENCY_BUCKETS_PER_DOUBLING);
+    return std::min(bound, _maxLatency);
+}
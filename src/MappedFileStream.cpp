@@ -0,0 +1,70 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "MappedFileStream.hpp"
+
+MappedFileStreamBuffer::MappedFileStreamBuffer(const char* path)
+{
+    _mapping = nullptr;
+    _size = 0;
+
+    int file = open(path, O_RDONLY);
+    if (file < 0)
+        throw mapped_file_exception();
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || !S_ISREG(status.st_mode))
+    {
+        close(file);
+        throw mapped_file_exception();
+    }
+
+    // An empty file has nothing to map, and is read as an empty input
+    _size = status.st_size;
+
+    if (_size > 0)
+    {
+        void* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping == MAP_FAILED)
+        {
+            close(file);
+            throw mapped_file_exception();
+        }
+
+        madvise(mapping, _size, MADV_SEQUENTIAL);
+        _mapping = (char*)mapping;
+    }
+
+    close(file);
+    setg(_mapping, _mapping, _mapping + _size);
+}
+
+MappedFileStreamBuffer::~MappedFileStreamBuffer()
+{
+    if (_mapping != nullptr)
+        munmap(_mapping, _size);
+}
+
+MappedFileStreamBuffer::pos_type MappedFileStreamBuffer::seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode)
+{
+    off_type base = direction == std::ios_base::beg ? 0 : direction == std::ios_base::cur ? gptr() - eback() : (off_type)_size;
+    off_type position = base + offset;
+
+    if (position < 0 || position > (off_type)_size)
+        return pos_type(off_type(-1));
+
+    setg(_mapping, _mapping + position, _mapping + _size);
+    return pos_type(position);
+}
+
+MappedFileStreamBuffer::pos_type MappedFileStreamBuffer::seekpos(pos_type position, std::ios_base::openmode mode)
+{
+    return seekoff(off_type(position), std::ios_base::beg, mode);
+}
+
+size_t MappedFileStreamBuffer::Size()
+{
+    return _size;
+}
@@ -0,0 +1,78 @@
+#include "MonotonicArena.hpp"
+
+MonotonicArena::MonotonicArena(size_t blockSize)
+{
+    _blocks.push_back({ new char[blockSize > 0 ? blockSize : 1], blockSize > 0 ? blockSize : 1 });
+    UseBlock(0);
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    for (ArenaBlock& block : _blocks)
+        delete[] block.memory;
+}
+
+void MonotonicArena::UseBlock(size_t index)
+{
+    _currentBlock = index;
+    _next = _blocks[index].memory;
+    _end = _blocks[index].memory + _blocks[index].size;
+}
+
+void* MonotonicArena::AllocateSlow(size_t size, size_t alignment)
+{
+    // Blocks kept from a previous use are filled before any new one is created
+    while (_currentBlock + 1 < _blocks.size())
+    {
+        UseBlock(_currentBlock + 1);
+
+        uintptr_t address = ((uintptr_t)_next + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        if (address + size <= (uintptr_t)_end)
+            return Allocate(size, alignment);
+    }
+
+    size_t blockSize = _blocks.back().size * 2;
+    if (blockSize < size + alignment)
+        blockSize = size + alignment;
+
+    _blocks.push_back({ new char[blockSize], blockSize });
+    UseBlock(_blocks.size() - 1);
+
+    return Allocate(size, alignment);
+}
+
+void MonotonicArena::Reset()
+{
+    if (_blocks.size() > 1)
+    {
+        size_t total = ReservedBytes();
+        char* merged = new char[total];
+
+        for (ArenaBlock& block : _blocks)
+            delete[] block.memory;
+
+        _blocks.assign(1, { merged, total });
+    }
+
+    UseBlock(0);
+}
+
+size_t MonotonicArena::UsedBytes()
+{
+    size_t used = _next - _blocks[_currentBlock].memory;
+
+    for (size_t i = 0; i < _currentBlock; i++)
+        used += _blocks[i].size;
+
+    return used;
+}
+
+size_t MonotonicArena::ReservedBytes()
+{
+    size_t reserved = 0;
+
+    for (ArenaBlock& block : _blocks)
+        reserved += block.size;
+
+    return reserved;
+}
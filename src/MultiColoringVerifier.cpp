@@ -0,0 +1,224 @@
+#include <cstring>
+#include <algorithm>
+
+#include "MultiColoringVerifier.hpp"
+#include "GraphRunner.hpp"
+#include "Stats.hpp"
+
+MultiColoringVerifier::MultiColoringVerifier(Graph* graph, int blockSize)
+{
+    _graph = graph;
+    _blockSize = std::max(blockSize, 1);
+    _maxDegree = 0;
+
+    _offsets.push_back(0);
+
+    LinkedList<Vertex*>* vertices = graph->GetVertices();
+    for (Node<Vertex*>* node = vertices->Empty() ? nullptr : vertices->GetNode(0); node != nullptr; node = node->next)
+    {
+        LinkedList<Vertex*>* adjacentVertices = node->data->GetAdjacentVertices();
+
+        for (Node<Vertex*>* adjacent = adjacentVertices->Empty() ? nullptr : adjacentVertices->GetNode(0); adjacent != nullptr; adjacent = adjacent->next)
+            _neighbors.push_back(adjacent->data->GetId());
+
+        _maxDegree = std::max(_maxDegree, adjacentVertices->Length());
+        _offsets.push_back(_neighbors.size());
+    }
+
+    _block.assign((size_t)graph->VertexCount() * _blockSize, UNDEFINED_COLOR);
+    _seen.resize((size_t)_blockSize * (_maxDegree + 2));
+    _missing.resize(_blockSize);
+    _conflict.resize(_blockSize);
+}
+
+int MultiColoringVerifier::BlockSize()
+{
+    return _blockSize;
+}
+
+void MultiColoringVerifier::LoadColoring(int slot, const std::vector<int>& colors)
+{
+    for (size_t v = 0; v + 1 < _offsets.size(); v++)
+        _block[v * _blockSize + slot] = colors[v];
+}
+
+int MultiColoringVerifier::ReadBlock(std::istream& input)
+{
+    int vertexCount = _offsets.size() - 1;
+    if (vertexCount == 0)
+        return 0;
+
+    for (int slot = 0; slot < _blockSize; slot++)
+    {
+        // The end of the input between two colorings is not an error
+        if (input.eof() || (input >> std::ws).eof())
+            return slot;
+
+        for (int v = 0; v < vertexCount; v++)
+            input >> _block[(size_t)v * _blockSize + slot];
+
+        if (input.fail())
+            return slot;
+    }
+
+    return _blockSize;
+}
+
+std::vector<ColoringVerdict> MultiColoringVerifier::VerifyBlock(int count)
+{
+    STATS_PHASE("is_greedy");
+
+    std::vector<ColoringVerdict> verdicts(count, COLORING_GREEDY);
+    std::vector<char> done(count, false);
+    std::vector<int> bound(count);
+
+    // seen[b * stride + c] is the last vertex that found a neighbor of color c in the coloring b
+    int stride = _maxDegree + 2;
+    std::fill(_seen.begin(), _seen.end(), -1);
+
+    for (int v = 0; v + 1 < (int)_offsets.size(); v++)
+    {
+        const int* colors = &_block[(size_t)v * _blockSize];
+        int degree = _offsets[v + 1] - _offsets[v];
+
+        // Only the colors below the color of v count, and none if its color is above degree + 1
+        for (int b = 0; b < count; b++)
+        {
+            bound[b] = colors[b] <= degree + 1 ? colors[b] : 0;
+            _missing[b] = std::max(bound[b] - 1, 0);
+            _conflict[b] = false;
+        }
+
+        // The colors of a neighbor in every coloring of the block are read together
+        for (int i = _offsets[v]; i < _offsets[v + 1]; i++)
+        {
+            int u = _neighbors[i];
+            const int* neighborColors = &_block[(size_t)u * _blockSize];
+
+            for (int b = 0; b < count; b++)
+            {
+                int color = neighborColors[b];
+
+                // SetVertexColor only compares with the vertices that already have a color
+                _conflict[b] |= u < v && color == colors[b];
+
+                if (color >= 1 && color < bound[b] && _seen[b * stride + color] != v)
+                {
+                    _seen[b * stride + color] = v;
+                    _missing[b]--;
+                }
+            }
+        }
+
+        // The errors are checked in the same order as SetVertexColor, and the first one is the answer
+        for (int b = 0; b < count; b++)
+        {
+            if (done[b])
+                continue;
+
+            if (colors[b] < 0)
+            {
+                verdicts[b] = COLORING_INVALID_COLOR;
+                done[b] = true;
+            }
+            else if (_conflict[b])
+            {
+                verdicts[b] = COLORING_UNAVAILABLE_COLOR;
+                done[b] = true;
+            }
+            else if (colors[b] != 1 && (bound[b] < 2 || _missing[b] > 0))
+                verdicts[b] = COLORING_NOT_GREEDY;
+        }
+    }
+
+    return verdicts;
+}
+
+void MultiColoringVerifier::WriteAnswer(int slot, ColoringVerdict verdict, OutputWriter& output, int firstCount)
+{
+    if (verdict == COLORING_GREEDY || verdict == COLORING_NOT_GREEDY)
+    {
+        if (verdict == COLORING_GREEDY)
+        {
+            std::vector<int> colors(_offsets.size() - 1);
+            for (size_t v = 0; v < colors.size(); v++)
+                colors[v] = _block[v * _blockSize + slot];
+
+            _graph->ReplaceColors(colors);
+        }
+
+        GraphRunner::WriteAnswer(_graph, verdict == COLORING_GREEDY, output, firstCount);
+        return;
+    }
+
+    // The message is the same one described for the exception that SetVertexColor would throw
+    const char* message;
+
+    try
+    {
+        if (verdict == COLORING_INVALID_COLOR)
+            throw invalid_color_change_exception();
+
+        throw unavailable_color_exception();
+    }
+    catch(...)
+    {
+        message = GraphRunner::DescribeCurrentException();
+    }
+
+    output.WriteBytes(message, strlen(message));
+    output.WriteChar('\n');
+}
+
+long MultiColoringVerifier::Run(std::istream& input, OutputWriter& output, int firstCount, int blockSize)
+{
+    Graph* graph = nullptr;
+    long answers = 0;
+
+    try
+    {
+        {
+            STATS_PHASE("parse");
+            graph = Graph::BuildTopologyFromIoStream(input);
+        }
+
+        if (input.fail())
+            throw malformed_input_exception();
+
+        MultiColoringVerifier verifier(graph, blockSize);
+
+        for (int count = verifier.BlockSize(); count == verifier.BlockSize(); )
+        {
+            count = verifier.ReadBlock(input);
+            std::vector<ColoringVerdict> verdicts = verifier.VerifyBlock(count);
+
+            for (int slot = 0; slot < count; slot++, answers++)
+                verifier.WriteAnswer(slot, verdicts[slot], output, firstCount);
+
+            if (input.fail())
+                throw malformed_input_exception();
+        }
+
+        // As for a single graph, the input must have at least one coloring
+        if (answers == 0)
+            throw malformed_input_exception();
+    }
+    catch(output_write_exception)
+    {
+        delete graph;
+        throw;
+    }
+    catch(...)
+    {
+        const char* message = GraphRunner::DescribeCurrentException();
+
+        output.WriteBytes(message, strlen(message));
+        output.WriteChar('\n');
+        answers++;
+    }
+
+    delete graph;
+    output.Flush();
+
+    return answers;
+}
@@ -0,0 +1,72 @@
+#include "OrderedVertexStream.hpp"
+
+OrderedVertexStream::OrderedVertexStream(LinkedList<Vertex*>* list)
+{
+    _size = list->Length();
+    _heap = new Vertex*[_size > 0 ? _size : 1];
+
+    int i = 0;
+    for (Node<Vertex*>* node = list->Empty() ? nullptr : list->GetNode(0); node != nullptr; node = node->next)
+    {
+        _heap[i++] = node->data;
+    }
+
+    for (int j = _size / 2 - 1; j >= 0; j--)
+    {
+        SiftDown(j);
+    }
+}
+
+OrderedVertexStream::~OrderedVertexStream()
+{
+    delete[] _heap;
+}
+
+void OrderedVertexStream::SiftDown(int index)
+{
+    while (true)
+    {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+
+        if (left < _size && _heap[smallest]->IsBiggerThan(_heap[left]))
+            smallest = left;
+
+        if (right < _size && _heap[smallest]->IsBiggerThan(_heap[right]))
+            smallest = right;
+
+        if (smallest == index)
+            return;
+
+        Vertex* temp = _heap[index];
+        _heap[index] = _heap[smallest];
+        _heap[smallest] = temp;
+
+        index = smallest;
+    }
+}
+
+bool OrderedVertexStream::HasNext()
+{
+    return _size > 0;
+}
+
+Vertex* OrderedVertexStream::Next()
+{
+    if (_size == 0)
+        throw stream_exhausted_exception();
+
+    Vertex* next = _heap[0];
+
+    _size--;
+    _heap[0] = _heap[_size];
+    SiftDown(0);
+
+    return next;
+}
+
+int OrderedVertexStream::Remaining()
+{
+    return _size;
+}
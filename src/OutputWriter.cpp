@@ -0,0 +1,117 @@
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <unistd.h>
+
+#include "OutputWriter.hpp"
+
+#define MAX_INTEGER_LENGTH (20)
+
+OutputWriter::OutputWriter(int fileDescriptor, size_t capacity)
+{
+    _fileDescriptor = fileDescriptor;
+    _destination = nullptr;
+    _capacity = capacity < MAX_INTEGER_LENGTH ? MAX_INTEGER_LENGTH : capacity;
+    _buffer = new char[_capacity];
+    _length = 0;
+}
+
+OutputWriter::OutputWriter(std::string& destination, size_t capacity)
+{
+    _fileDescriptor = -1;
+    _destination = &destination;
+    _capacity = capacity < MAX_INTEGER_LENGTH ? MAX_INTEGER_LENGTH : capacity;
+    _buffer = new char[_capacity];
+    _length = 0;
+}
+
+OutputWriter::~OutputWriter()
+{
+    try
+    {
+        Flush();
+    }
+    catch(output_write_exception)
+    {}
+
+    delete[] _buffer;
+}
+
+void OutputWriter::Reserve(size_t bytes)
+{
+    if (_length + bytes > _capacity)
+        Flush();
+}
+
+void OutputWriter::WriteInt(long long value)
+{
+    Reserve(MAX_INTEGER_LENGTH);
+
+    std::to_chars_result result = std::to_chars(_buffer + _length, _buffer + _capacity, value);
+    _length = result.ptr - _buffer;
+}
+
+void OutputWriter::WriteChar(char character)
+{
+    Reserve(1);
+    _buffer[_length++] = character;
+}
+
+void OutputWriter::WriteBytes(const char* data, size_t length)
+{
+    while (length > 0)
+    {
+        Reserve(length < _capacity ? length : _capacity);
+
+        size_t chunk = _capacity - _length < length ? _capacity - _length : length;
+        memcpy(_buffer + _length, data, chunk);
+
+        _length += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+void OutputWriter::Flush()
+{
+    if (_destination != nullptr)
+    {
+        _destination->append(_buffer, _length);
+        _length = 0;
+        return;
+    }
+
+    size_t written = 0;
+
+    while (written < _length)
+    {
+        ssize_t result = write(_fileDescriptor, _buffer + written, _length - written);
+
+        if (result < 0 && errno == EINTR)
+            continue;
+
+        if (result <= 0)
+        {
+            _length = 0;
+            throw output_write_exception();
+        }
+
+        written += result;
+    }
+
+    _length = 0;
+}
+
+void OutputWriter::Redirect(int fileDescriptor)
+{
+    Flush();
+    _fileDescriptor = fileDescriptor;
+    _destination = nullptr;
+}
+
+void OutputWriter::Redirect(std::string& destination)
+{
+    Flush();
+    _fileDescriptor = -1;
+    _destination = &destination;
+}
@@ -0,0 +1,315 @@
+#include <algorithm>
+
+#include "PackedKeySorter.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PACKED_KEY_SORTER_X86
+#endif
+
+#define NETWORK_SIZE (16)
+#define MAX_KEY (0x7FFFFFFFFFFFFFFFLL)
+
+long long PackedKeySorter::Pack(Vertex* vertex)
+{
+    unsigned long long color = (unsigned long long)(long long)vertex->GetColor();
+    return (long long)((color << 32) | (unsigned int)vertex->GetId());
+}
+
+int PackedKeySorter::UnpackId(long long key)
+{
+    return (int)(key & 0xFFFFFFFFLL);
+}
+
+bool PackedKeySorter::HasAvx2()
+{
+#ifdef PACKED_KEY_SORTER_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void PackedKeySorter::Sort(long long* keys, int length)
+{
+    if (HasAvx2())
+        SortAvx2(keys, length);
+    else
+        SortScalar(keys, length);
+}
+
+void PackedKeySorter::SortScalar(long long* keys, int length)
+{
+    std::sort(keys, keys + length);
+}
+
+#ifdef PACKED_KEY_SORTER_X86
+
+#define AVX2 __attribute__((target("avx2")))
+
+/**
+ * Permutation (in 32-bit lanes) that moves the 64-bit lanes selected by a 4-bit mask to the
+ * beginning of the register, keeping their relative order.
+ */
+struct CompressTable
+{
+    int indexes[16][8];
+
+    CompressTable()
+    {
+        for (int mask = 0; mask < 16; mask++)
+        {
+            int position = 0;
+            for (int lane = 0; lane < 4; lane++)
+            {
+                if (mask & (1 << lane))
+                {
+                    indexes[mask][position++] = 2 * lane;
+                    indexes[mask][position++] = 2 * lane + 1;
+                }
+            }
+
+            while (position < 8)
+            {
+                indexes[mask][position] = position;
+                position++;
+            }
+        }
+    }
+};
+
+static const CompressTable compressTable;
+
+AVX2 static inline void MinMax(__m256i& low, __m256i& high)
+{
+    __m256i greater = _mm256_cmpgt_epi64(low, high);
+    __m256i minimum = _mm256_blendv_epi8(low, high, greater);
+    high = _mm256_blendv_epi8(high, low, greater);
+    low = minimum;
+}
+
+AVX2 static inline __m256i Reverse(__m256i vector)
+{
+    return _mm256_permute4x64_epi64(vector, 0x1B);
+}
+
+// Sorts a bitonic sequence of 4 keys stored in a single register.
+AVX2 static inline __m256i BitonicClean4(__m256i vector)
+{
+    __m256i swapped = _mm256_permute4x64_epi64(vector, 0x4E);
+    __m256i low = vector, high = swapped;
+    MinMax(low, high);
+    vector = _mm256_blend_epi32(low, high, 0xF0);
+
+    swapped = _mm256_permute4x64_epi64(vector, 0xB1);
+    low = vector;
+    high = swapped;
+    MinMax(low, high);
+    return _mm256_blend_epi32(low, high, 0xCC);
+}
+
+// Sorts a bitonic sequence of 8 keys stored in two registers.
+AVX2 static inline void BitonicClean8(__m256i& first, __m256i& second)
+{
+    MinMax(first, second);
+    first = BitonicClean4(first);
+    second = BitonicClean4(second);
+}
+
+// Merges two sorted registers into 8 sorted keys.
+AVX2 static inline void Merge4(__m256i& first, __m256i& second)
+{
+    second = Reverse(second);
+    MinMax(first, second);
+    first = BitonicClean4(first);
+    second = BitonicClean4(second);
+}
+
+// Merges two sorted sequences of 8 keys into 16 sorted keys.
+AVX2 static inline void Merge8(__m256i& a0, __m256i& a1, __m256i& b0, __m256i& b1)
+{
+    __m256i reversed0 = Reverse(b1);
+    __m256i reversed1 = Reverse(b0);
+
+    MinMax(a0, reversed0);
+    MinMax(a1, reversed1);
+
+    BitonicClean8(a0, a1);
+    BitonicClean8(reversed0, reversed1);
+
+    b0 = reversed0;
+    b1 = reversed1;
+}
+
+// Sorting network for up to 16 keys, the missing positions are filled with the biggest key.
+AVX2 static void SortNetwork16(long long* keys, int length)
+{
+    alignas(32) long long buffer[NETWORK_SIZE];
+
+    for (int i = 0; i < NETWORK_SIZE; i++)
+    {
+        buffer[i] = i < length ? keys[i] : MAX_KEY;
+    }
+
+    __m256i r0 = _mm256_load_si256((__m256i*)(buffer + 0));
+    __m256i r1 = _mm256_load_si256((__m256i*)(buffer + 4));
+    __m256i r2 = _mm256_load_si256((__m256i*)(buffer + 8));
+    __m256i r3 = _mm256_load_si256((__m256i*)(buffer + 12));
+
+    // Sorts the columns
+    MinMax(r0, r1);
+    MinMax(r2, r3);
+    MinMax(r0, r2);
+    MinMax(r1, r3);
+    MinMax(r1, r2);
+
+    // Transposes, each register now holds a sorted column
+    __m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+    __m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+    __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+    __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+
+    r0 = _mm256_permute2x128_si256(t0, t2, 0x20);
+    r1 = _mm256_permute2x128_si256(t1, t3, 0x20);
+    r2 = _mm256_permute2x128_si256(t0, t2, 0x31);
+    r3 = _mm256_permute2x128_si256(t1, t3, 0x31);
+
+    Merge4(r0, r1);
+    Merge4(r2, r3);
+    Merge8(r0, r1, r2, r3);
+
+    _mm256_store_si256((__m256i*)(buffer + 0), r0);
+    _mm256_store_si256((__m256i*)(buffer + 4), r1);
+    _mm256_store_si256((__m256i*)(buffer + 8), r2);
+    _mm256_store_si256((__m256i*)(buffer + 12), r3);
+
+    for (int i = 0; i < length; i++)
+    {
+        keys[i] = buffer[i];
+    }
+}
+
+/**
+ * Partitions the keys into those smaller than the pivot (kept at the beginning of the array)
+ * and the remaining ones (copied after them through the auxiliary buffer).
+ * Returns the number of keys smaller than the pivot.
+ */
+AVX2 static int VectorizedPartition(long long* keys, int length, long long pivot, long long* buffer)
+{
+    __m256i pivotVector = _mm256_set1_epi64x(pivot);
+
+    int smaller = 0;
+    int bigger = 0;
+    int i = 0;
+
+    for (; i + 4 <= length; i += 4)
+    {
+        __m256i vector = _mm256_loadu_si256((__m256i*)(keys + i));
+        __m256i isSmaller = _mm256_cmpgt_epi64(pivotVector, vector);
+
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(isSmaller));
+        int smallerCount = __builtin_popcount(mask);
+
+        __m256i smallerIndexes = _mm256_loadu_si256((__m256i*)compressTable.indexes[mask]);
+        __m256i biggerIndexes = _mm256_loadu_si256((__m256i*)compressTable.indexes[~mask & 0xF]);
+
+        _mm256_storeu_si256((__m256i*)(keys + smaller), _mm256_permutevar8x32_epi32(vector, smallerIndexes));
+        _mm256_storeu_si256((__m256i*)(buffer + bigger), _mm256_permutevar8x32_epi32(vector, biggerIndexes));
+
+        smaller += smallerCount;
+        bigger += 4 - smallerCount;
+    }
+
+    for (; i < length; i++)
+    {
+        if (keys[i] < pivot)
+            keys[smaller++] = keys[i];
+        else
+            buffer[bigger++] = keys[i];
+    }
+
+    for (int j = 0; j < bigger; j++)
+    {
+        keys[smaller + j] = buffer[j];
+    }
+
+    return smaller;
+}
+
+static long long MedianOfThree(long long a, long long b, long long c)
+{
+    if (a < b)
+        return b < c ? b : (a < c ? c : a);
+
+    return a < c ? a : (b < c ? c : b);
+}
+
+AVX2 static void VectorizedQuickSort(long long* keys, int length, long long* buffer, int depth)
+{
+    while (length > NETWORK_SIZE)
+    {
+        if (depth-- == 0)
+        {
+            std::sort(keys, keys + length);
+            return;
+        }
+
+        long long pivot = MedianOfThree(keys[0], keys[length / 2], keys[length - 1]);
+        int smaller = VectorizedPartition(keys, length, pivot, buffer);
+
+        // Every key is at least the pivot: the ones equal to it are already in place
+        if (smaller == 0)
+        {
+            int equal = 0;
+            for (int i = 0; i < length; i++)
+            {
+                if (keys[i] == pivot)
+                    std::swap(keys[i], keys[equal++]);
+            }
+
+            keys += equal;
+            length -= equal;
+            continue;
+        }
+
+        if (smaller < length - smaller)
+        {
+            VectorizedQuickSort(keys, smaller, buffer, depth);
+            keys += smaller;
+            length -= smaller;
+        }
+        else
+        {
+            VectorizedQuickSort(keys + smaller, length - smaller, buffer, depth);
+            length = smaller;
+        }
+    }
+
+    SortNetwork16(keys, length);
+}
+
+void PackedKeySorter::SortAvx2(long long* keys, int length)
+{
+    if (length < 2)
+        return;
+
+    int depth = 0;
+    for (int n = length; n > 1; n >>= 1)
+    {
+        depth += 2;
+    }
+
+    long long* buffer = new long long[length];
+    VectorizedQuickSort(keys, length, buffer, depth);
+    delete[] buffer;
+}
+
+#else
+
+void PackedKeySorter::SortAvx2(long long* keys, int length)
+{
+    SortScalar(keys, length);
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "PerfCounters.hpp"
+
+/**
+ * Opens one user space counter of the calling thread, returning its file descriptor or a negative number.
+ */
+int OpenPerfEvent(uint32_t type, uint64_t config)
+{
+    perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+
+    attributes.size = sizeof(attributes);
+    attributes.type = type;
+    attributes.config = config;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+PerfCounters::PerfCounters()
+{
+    const uint64_t l1dMisses = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    _fileDescriptors[PERF_CYCLES] = OpenPerfEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    _fileDescriptors[PERF_INSTRUCTIONS] = OpenPerfEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    _fileDescriptors[PERF_L1D_MISSES] = OpenPerfEvent(PERF_TYPE_HW_CACHE, l1dMisses);
+    _fileDescriptors[PERF_LLC_MISSES] = OpenPerfEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    _fileDescriptors[PERF_BRANCH_MISSES] = OpenPerfEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        if (_fileDescriptors[i] >= 0)
+            close(_fileDescriptors[i]);
+    }
+}
+
+bool PerfCounters::IsAvailable()
+{
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        if (_fileDescriptors[i] >= 0)
+            return true;
+    }
+
+    return false;
+}
+
+void PerfCounters::Read(long long* values)
+{
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        // Value, time enabled and time running
+        uint64_t data[3];
+
+        if (_fileDescriptors[i] < 0 || read(_fileDescriptors[i], data, sizeof(data)) != sizeof(data))
+        {
+            values[i] = PERF_UNAVAILABLE;
+            continue;
+        }
+
+        if (data[2] == 0)
+            values[i] = 0;
+        else if (data[2] < data[1])
+            values[i] = (long long)((double)data[0] * data[1] / data[2]);
+        else
+            values[i] = (long long)data[0];
+    }
+}
+
+const char* PerfCounters::EventName(PerfEvent event)
+{
+    switch (event)
+    {
+        case PERF_CYCLES:
+            return "cycles";
+        case PERF_INSTRUCTIONS:
+            return "instructions";
+        case PERF_L1D_MISSES:
+            return "l1d_misses";
+        case PERF_LLC_MISSES:
+            return "llc_misses";
+        case PERF_BRANCH_MISSES:
+            return "branch_misses";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,223 @@
+#include <string>
+#include <thread>
+#include <cstdint>
+
+#include "ProgramOptions.hpp"
+
+/**
+ * Reads a non-negative integer option value, failing if it is missing or malformed.
+ */
+int ParseCount(int argc, char const *argv[], int& index)
+{
+    if (index + 1 >= argc)
+        throw invalid_program_argument_exception();
+
+    std::string value = argv[++index];
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos || value.size() > 9)
+        throw invalid_program_argument_exception();
+
+    return std::stoi(value);
+}
+
+/**
+ * Reads a positive size in bytes, optionally followed by the suffix K, M or G.
+ */
+size_t ParseSize(int argc, char const *argv[], int& index)
+{
+    if (index + 1 >= argc)
+        throw invalid_program_argument_exception();
+
+    std::string value = argv[++index];
+
+    size_t multiplier = 1;
+    char suffix = value.empty() ? '\0' : value.back();
+    if (suffix == 'K' || suffix == 'k')
+        multiplier = 1024;
+    else if (suffix == 'M' || suffix == 'm')
+        multiplier = 1024 * 1024;
+    else if (suffix == 'G' || suffix == 'g')
+        multiplier = 1024 * 1024 * 1024;
+
+    if (multiplier != 1)
+        value.pop_back();
+
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos || value.size() > 12)
+        throw invalid_program_argument_exception();
+
+    // A value that does not fit in size_t after the multiplier would wrap around to a wrong budget
+    size_t size = std::stoull(value);
+    if (size == 0 || size > SIZE_MAX / multiplier)
+        throw invalid_program_argument_exception();
+
+    return size * multiplier;
+}
+
+/**
+ * Reads the name of a relabeling order.
+ */
+RelabelOrder ParseRelabelOrder(const char* name)
+{
+    try
+    {
+        return VertexRelabeler::ParseOrder(name);
+    }
+    catch(invalid_relabel_order_exception)
+    {
+        throw invalid_program_argument_exception();
+    }
+}
+
+ProgramOptions::ProgramOptions()
+{
+    _firstCount = ALL_VERTICES;
+    _verbose = false;
+    _memoryBudget = DEFAULT_MEMORY_BUDGET;
+    _binary = false;
+    _outputPath = nullptr;
+    _socketPath = nullptr;
+    _batchPattern = nullptr;
+    _pipeline = false;
+    _colorings = false;
+    _streamPath = nullptr;
+    _stats = false;
+    _statsTracePath = nullptr;
+    _perf = false;
+    _relabelOrder = RELABEL_NONE;
+    _processCount = 0;
+    _numa = false;
+    _workerCount = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+}
+
+ProgramOptions ProgramOptions::Parse(int argc, char const *argv[])
+{
+    ProgramOptions options;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+
+        if (argument == "-k" || argument == "--first")
+            options._firstCount = ParseCount(argc, argv, i);
+        else if (argument == "-v" || argument == "--verbose")
+            options._verbose = true;
+        else if (argument == "-m" || argument == "--memory")
+            options._memoryBudget = ParseSize(argc, argv, i);
+        else if (argument == "-b" || argument == "--binary")
+            options._binary = true;
+        else if ((argument == "-o" || argument == "--output") && i + 1 < argc)
+            options._outputPath = argv[++i];
+        else if ((argument == "-S" || argument == "--serve") && i + 1 < argc)
+            options._socketPath = argv[++i];
+        else if ((argument == "-B" || argument == "--batch") && i + 1 < argc)
+            options._batchPattern = argv[++i];
+        else if (argument == "-P" || argument == "--pipeline")
+            options._pipeline = true;
+        else if (argument == "-C" || argument == "--colorings")
+            options._colorings = true;
+        else if ((argument == "-s" || argument == "--stream") && i + 1 < argc)
+            options._streamPath = argv[++i];
+        else if (argument == "--stats")
+            options._stats = true;
+        else if (argument == "--stats-trace" && i + 1 < argc)
+            options._statsTracePath = argv[++i];
+        else if (argument == "--perf")
+            options._perf = options._stats = true;
+        else if (argument == "-w" || argument == "--workers")
+            options._workerCount = ParseCount(argc, argv, i);
+        else if ((argument == "-r" || argument == "--relabel") && i + 1 < argc)
+            options._relabelOrder = ParseRelabelOrder(argv[++i]);
+        else if (argument == "-p" || argument == "--processes")
+            options._processCount = ParseCount(argc, argv, i);
+        else if (argument == "--numa")
+            options._numa = true;
+        else
+            throw invalid_program_argument_exception();
+    }
+
+    return options;
+}
+
+int ProgramOptions::GetFirstCount()
+{
+    return _firstCount;
+}
+
+bool ProgramOptions::IsVerbose()
+{
+    return _verbose;
+}
+
+size_t ProgramOptions::GetMemoryBudget()
+{
+    return _memoryBudget;
+}
+
+bool ProgramOptions::IsBinary()
+{
+    return _binary;
+}
+
+const char* ProgramOptions::GetOutputPath()
+{
+    return _outputPath;
+}
+
+const char* ProgramOptions::GetSocketPath()
+{
+    return _socketPath;
+}
+
+const char* ProgramOptions::GetBatchPattern()
+{
+    return _batchPattern;
+}
+
+bool ProgramOptions::IsPipeline()
+{
+    return _pipeline;
+}
+
+bool ProgramOptions::IsColorings()
+{
+    return _colorings;
+}
+
+const char* ProgramOptions::GetStreamPath()
+{
+    return _streamPath;
+}
+
+bool ProgramOptions::IsStats()
+{
+    return _stats;
+}
+
+const char* ProgramOptions::GetStatsTracePath()
+{
+    return _statsTracePath;
+}
+
+bool ProgramOptions::IsPerf()
+{
+    return _perf;
+}
+
+int ProgramOptions::GetWorkerCount()
+{
+    return _workerCount;
+}
+
+RelabelOrder ProgramOptions::GetRelabelOrder()
+{
+    return _relabelOrder;
+}
+
+int ProgramOptions::GetProcessCount()
+{
+    return _processCount;
+}
+
+bool ProgramOptions::IsNuma()
+{
+    return _numa;
+}
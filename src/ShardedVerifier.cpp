@@ -0,0 +1,180 @@
+#include <sched.h>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "ShardedVerifier.hpp"
+
+// Exit statuses of the workers
+#define SHARD_GREEDY (0)
+#define SHARD_NOT_GREEDY (1)
+#define SHARD_STOPPED (2)
+
+/**
+ * Reads a list of processors in the format of the kernel (e.g. "0-3,8,10-11").
+ */
+std::vector<int> ParseProcessorList(const std::string& text)
+{
+    std::vector<int> processors;
+    std::stringstream stream(text);
+    std::string range;
+
+    while (std::getline(stream, range, ','))
+    {
+        size_t dash = range.find('-');
+
+        try
+        {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+            for (int processor = first; processor <= last; processor++)
+                processors.push_back(processor);
+        }
+        catch(...)
+        {}
+    }
+
+    return processors;
+}
+
+ShardedVerifier::ShardedVerifier(SharedGraph& graph, int processCount, bool pinNuma) : _graph(graph)
+{
+    _processCount = processCount > 0 ? processCount : 1;
+    _pinNuma = pinNuma;
+    _stoppedCount = 0;
+    _pinnedCount = 0;
+}
+
+void ShardedVerifier::WorkerMain(int start, int end, const std::vector<int>& node, std::vector<int>& seen)
+{
+    if (!node.empty())
+    {
+        cpu_set_t processors;
+        CPU_ZERO(&processors);
+
+        for (int processor : node)
+            CPU_SET(processor, &processors);
+
+        sched_setaffinity(0, sizeof(processors), &processors);
+    }
+
+    std::atomic<int>& stop = _graph.StopFlag();
+
+    for (int position = start; position < end; position++)
+    {
+        if ((position - start) % STOP_CHECK_INTERVAL == 0 && stop.load(std::memory_order_relaxed) != 0)
+            _exit(SHARD_STOPPED);
+
+        if (!_graph.IsGreedyVertex(position, seen))
+        {
+            _graph.RecordFailure(position);
+            _exit(SHARD_NOT_GREEDY);
+        }
+    }
+
+    // _exit skips the destructors and buffers inherited from the coordinator
+    _exit(SHARD_GREEDY);
+}
+
+bool ShardedVerifier::Run()
+{
+    std::vector<int> starts = _graph.SplitShards(_processCount);
+    std::vector<std::vector<int>> nodes = _pinNuma ? NumaNodes() : std::vector<std::vector<int>>();
+    std::vector<pid_t> workers;
+
+    // Allocated before the fork, so the workers never allocate memory
+    std::vector<int> seen(_graph.MaxDegree() + 2, -1);
+    std::vector<int> noNode;
+
+    _graph.ResetFailure();
+    _stoppedCount = 0;
+    _pinnedCount = nodes.empty() ? 0 : _processCount;
+
+    bool failed = false;
+
+    for (int i = 0; i < _processCount && !failed; i++)
+    {
+        pid_t worker = fork();
+
+        if (worker == 0)
+            WorkerMain(starts[i], starts[i + 1], nodes.empty() ? noNode : nodes[i % nodes.size()], seen);
+
+        if (worker < 0)
+        {
+            // The workers already created are stopped before the error is reported
+            _graph.StopFlag().store(1);
+            failed = true;
+        }
+        else
+            workers.push_back(worker);
+    }
+
+    bool isGreedy = true;
+
+    for (pid_t worker : workers)
+    {
+        int status;
+
+        if (waitpid(worker, &status, 0) < 0 || !WIFEXITED(status))
+        {
+            failed = true;
+            continue;
+        }
+
+        switch (WEXITSTATUS(status))
+        {
+            case SHARD_GREEDY:
+            break;
+
+            case SHARD_NOT_GREEDY:
+                isGreedy = false;
+            break;
+
+            case SHARD_STOPPED:
+                _stoppedCount++;
+            break;
+
+            default:
+                failed = true;
+        }
+    }
+
+    // A worker that stopped early only did so because another one found a failure
+    if (failed || (_stoppedCount > 0 && isGreedy))
+        throw worker_process_exception();
+
+    return isGreedy;
+}
+
+int ShardedVerifier::StoppedCount()
+{
+    return _stoppedCount;
+}
+
+int ShardedVerifier::PinnedCount()
+{
+    return _pinnedCount;
+}
+
+std::vector<std::vector<int>> ShardedVerifier::NumaNodes()
+{
+    std::vector<std::vector<int>> nodes;
+
+    for (int node = 0; ; node++)
+    {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string text;
+
+        if (!file || !std::getline(file, text))
+            break;
+
+        std::vector<int> processors = ParseProcessorList(text);
+        if (!processors.empty())
+            nodes.push_back(processors);
+    }
+
+    return nodes;
+}
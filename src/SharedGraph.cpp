@@ -0,0 +1,209 @@
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <algorithm>
+#include <unordered_map>
+
+#include "SharedGraph.hpp"
+
+/**
+ * Rounds a size up to a multiple of 8 bytes, keeping every array of the segment aligned.
+ */
+size_t AlignShared(size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+
+SharedGraph::SharedGraph(Graph* graph)
+{
+    std::vector<Vertex*> vertices;
+    LinkedList<Vertex*>* list = graph->GetVertices();
+
+    for (Node<Vertex*>* node = list->Empty() ? nullptr : list->GetNode(0); node != nullptr; node = node->next)
+        vertices.push_back(node->data);
+
+    int64_t vertexCount = vertices.size(), adjacencyCount = 0;
+
+    // Positions of the vertices, found by their ids when they are exactly 0..n-1, as in the input
+    std::vector<int> positionById(vertexCount, -1);
+    bool denseIds = true;
+
+    for (int64_t i = 0; i < vertexCount; i++)
+    {
+        int id = vertices[i]->GetId();
+        adjacencyCount += vertices[i]->GetAdjacentVertices()->Length();
+
+        if (id < 0 || id >= vertexCount || positionById[id] != -1)
+            denseIds = false;
+        else if (denseIds)
+            positionById[id] = i;
+    }
+
+    std::unordered_map<Vertex*, int> positionByVertex;
+    for (int64_t i = 0; i < vertexCount && !denseIds; i++)
+        positionByVertex[vertices[i]] = i;
+
+    size_t idsStart = AlignShared(sizeof(SharedGraphHeader));
+    size_t colorsStart = idsStart + AlignShared(vertexCount * sizeof(int));
+    size_t offsetsStart = colorsStart + AlignShared(vertexCount * sizeof(int));
+    size_t neighborsStart = offsetsStart + AlignShared((vertexCount + 1) * sizeof(int64_t));
+    _size = neighborsStart + AlignShared(adjacencyCount * sizeof(int));
+
+    std::string name = "/tp2-graph-" + std::to_string(getpid()) + "-" + std::to_string((uintptr_t)this);
+
+    int file = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (file < 0)
+        throw shared_memory_exception();
+
+    // Without a name the segment cannot be left behind, it lives while some process has it mapped
+    shm_unlink(name.c_str());
+
+    if (ftruncate(file, _size) != 0)
+    {
+        close(file);
+        throw shared_memory_exception();
+    }
+
+    _memory = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+
+    if (_memory == MAP_FAILED)
+        throw shared_memory_exception();
+
+    char* bytes = (char*)_memory;
+    _header = new (bytes) SharedGraphHeader();
+    _ids = (int*)(bytes + idsStart);
+    _colors = (int*)(bytes + colorsStart);
+    _offsets = (int64_t*)(bytes + offsetsStart);
+    _neighbors = (int*)(bytes + neighborsStart);
+
+    _header->vertexCount = vertexCount;
+    _header->adjacencyCount = adjacencyCount;
+    _header->maxDegree = 0;
+    _header->stop.store(0);
+    _header->failedPosition.store(-1);
+
+    _offsets[0] = 0;
+
+    for (int64_t i = 0; i < vertexCount; i++)
+    {
+        _ids[i] = vertices[i]->GetId();
+        _colors[i] = vertices[i]->GetColor();
+
+        int64_t next = _offsets[i];
+        LinkedList<Vertex*>* adjacentVertices = vertices[i]->GetAdjacentVertices();
+
+        for (Node<Vertex*>* node = adjacentVertices->Empty() ? nullptr : adjacentVertices->GetNode(0); node != nullptr; node = node->next)
+            _neighbors[next++] = denseIds ? positionById[node->data->GetId()] : positionByVertex.at(node->data);
+
+        _offsets[i + 1] = next;
+        _header->maxDegree = std::max(_header->maxDegree, next - _offsets[i]);
+    }
+}
+
+SharedGraph::~SharedGraph()
+{
+    munmap(_memory, _size);
+}
+
+bool SharedGraph::IsGreedyVertex(int position, std::vector<int>& seen)
+{
+    int color = _colors[position];
+
+    if (color == 1)
+        return true;
+
+    if (color == UNDEFINED_COLOR || _offsets[position] == _offsets[position + 1])
+        return false;
+
+    if (_offsets[position + 1] - _offsets[position] < color - 1)
+        return false;
+
+    if ((int)seen.size() < color)
+        seen.resize(color, -1);
+
+    int missing = color - 1;
+
+    for (int64_t i = _offsets[position]; i < _offsets[position + 1] && missing > 0; i++)
+    {
+        int neighborColor = _colors[_neighbors[i]];
+
+        if (neighborColor == UNDEFINED_COLOR || neighborColor >= color || seen[neighborColor] == position)
+            continue;
+
+        seen[neighborColor] = position;
+        missing--;
+    }
+
+    return missing == 0;
+}
+
+std::vector<int> SharedGraph::SplitShards(int shardCount)
+{
+    int64_t vertexCount = _header->vertexCount;
+    int64_t total = vertexCount + _header->adjacencyCount;
+
+    std::vector<int> starts(shardCount + 1, (int)vertexCount);
+    starts[0] = 0;
+
+    // The work before the vertex at position p is p + offsets[p], which grows with p, so each start is a binary search
+    for (int shard = 1; shard < shardCount; shard++)
+    {
+        int64_t target = total * shard / shardCount;
+        int64_t low = starts[shard - 1], high = vertexCount;
+
+        while (low < high)
+        {
+            int64_t middle = (low + high) / 2;
+
+            if (middle + _offsets[middle] < target)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        starts[shard] = (int)low;
+    }
+
+    return starts;
+}
+
+void SharedGraph::RecordFailure(int position)
+{
+    int none = -1;
+    _header->failedPosition.compare_exchange_strong(none, position);
+    _header->stop.store(1);
+}
+
+void SharedGraph::ResetFailure()
+{
+    _header->failedPosition.store(-1);
+    _header->stop.store(0);
+}
+
+int SharedGraph::FailedId()
+{
+    int position = _header->failedPosition.load();
+    return position < 0 ? -1 : _ids[position];
+}
+
+std::atomic<int>& SharedGraph::StopFlag()
+{
+    return _header->stop;
+}
+
+int SharedGraph::VertexCount()
+{
+    return (int)_header->vertexCount;
+}
+
+int64_t SharedGraph::MaxDegree()
+{
+    return _header->maxDegree;
+}
+
+size_t SharedGraph::Size()
+{
+    return _size;
+}
@@ -0,0 +1,330 @@
+#include "Stats.hpp"
+
+#ifdef GRAPH_STATS
+
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <thread>
+#include <cstdlib>
+#include <functional>
+
+/**
+ * Phase recorded by one of the threads.
+ */
+struct StatsRecord
+{
+    std::string name;
+    double start;
+    double duration;
+    size_t thread;
+    long long counters[STATS_COUNTER_COUNT];
+    long long events[PERF_EVENT_COUNT];
+};
+
+std::mutex statsMutex;
+std::vector<StatsRecord> statsRecords;
+const std::chrono::steady_clock::time_point statsOrigin = std::chrono::steady_clock::now();
+
+// Every allocation of the program is counted while the instrumentation is compiled in
+void* operator new(size_t size)
+{
+    Stats::Add(STATS_ALLOCATIONS, 1);
+
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == nullptr)
+        throw std::bad_alloc();
+
+    return memory;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+/**
+ * Writes a text as a JSON string.
+ */
+void WriteJsonString(std::ostream& output, const std::string& text)
+{
+    output << '"';
+
+    for (char character : text)
+    {
+        if (character == '"' || character == '\\')
+            output << '\\';
+
+        output << character;
+    }
+
+    output << '"';
+}
+
+const char* Stats::CounterName(StatsCounter counter)
+{
+    switch (counter)
+    {
+        case STATS_COMPARISONS:
+            return "comparisons";
+        case STATS_SWAPS:
+            return "swaps";
+        case STATS_CURSOR_HITS:
+            return "cursor_hits";
+        case STATS_LINEAR_WALKS:
+            return "linear_walks";
+        case STATS_WALK_LENGTH:
+            return "walk_length";
+        case STATS_ALLOCATIONS:
+            return "allocations";
+        case STATS_VERTICES_READ:
+            return "vertices";
+        case STATS_EDGES_READ:
+            return "adjacencies";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * Hardware counters of the calling thread, opened on the first use.
+ */
+PerfCounters& ThreadPerfCounters()
+{
+    thread_local PerfCounters counters;
+    return counters;
+}
+
+bool Stats::EnableHardwareCounters()
+{
+    _hardwareCounters = true;
+    return ThreadPerfCounters().IsAvailable();
+}
+
+void Stats::ReadHardwareCounters(long long* values)
+{
+    ThreadPerfCounters().Read(values);
+}
+
+void Stats::RecordPhase(const std::string& name, std::chrono::steady_clock::time_point start,
+                        std::chrono::steady_clock::time_point end, const long long* deltas, const long long* events)
+{
+    StatsRecord record;
+    record.name = name;
+    record.start = std::chrono::duration<double, std::micro>(start - statsOrigin).count();
+    record.duration = std::chrono::duration<double, std::micro>(end - start).count();
+    record.thread = std::hash<std::thread::id>()(std::this_thread::get_id()) % 1000000;
+
+    for (int i = 0; i < STATS_COUNTER_COUNT; i++)
+        record.counters[i] = deltas[i];
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+        record.events[i] = events[i];
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    statsRecords.push_back(record);
+}
+
+void Stats::WriteReport(std::ostream& output)
+{
+    struct Summary
+    {
+        long count = 0;
+        double duration = 0;
+        long long counters[STATS_COUNTER_COUNT] = {};
+        long long events[PERF_EVENT_COUNT] = {};
+    };
+
+    std::vector<std::string> order;
+    std::map<std::string, Summary> summaries;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+
+        for (const StatsRecord& record : statsRecords)
+        {
+            if (summaries.count(record.name) == 0)
+                order.push_back(record.name);
+
+            Summary& summary = summaries[record.name];
+            summary.count++;
+            summary.duration += record.duration;
+
+            for (int i = 0; i < STATS_COUNTER_COUNT; i++)
+                summary.counters[i] += record.counters[i];
+
+            // An event unavailable in any of the runs is unavailable for the whole phase
+            for (int i = 0; i < PERF_EVENT_COUNT; i++)
+            {
+                if (record.events[i] == PERF_UNAVAILABLE || summary.events[i] == PERF_UNAVAILABLE)
+                    summary.events[i] = PERF_UNAVAILABLE;
+                else
+                    summary.events[i] += record.events[i];
+            }
+        }
+    }
+
+    output << "phase count milliseconds";
+    for (int i = 0; i < STATS_COUNTER_COUNT; i++)
+        output << " " << CounterName((StatsCounter)i);
+    output << std::endl;
+
+    // Phases in the order in which they first finished, so nested phases come before the enclosing ones
+    for (const std::string& name : order)
+    {
+        Summary& summary = summaries[name];
+        output << name << " " << summary.count << " " << summary.duration / 1000.0;
+
+        for (int i = 0; i < STATS_COUNTER_COUNT; i++)
+            output << " " << summary.counters[i];
+
+        output << std::endl;
+    }
+
+    if (!_hardwareCounters)
+        return;
+
+    // Size of the graphs read, so the misses can be compared between inputs of different sizes
+    // (each edge appears in the adjacency lists of both of its vertices)
+    long long vertices = summaries["parse"].counters[STATS_VERTICES_READ];
+    long long edges = summaries["parse"].counters[STATS_EDGES_READ] / 2;
+
+    const PerfEvent misses[] = { PERF_L1D_MISSES, PERF_LLC_MISSES, PERF_BRANCH_MISSES };
+
+    output << std::endl << "phase";
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+        output << " " << PerfCounters::EventName((PerfEvent)i);
+    output << " ipc";
+    for (PerfEvent event : misses)
+        output << " " << PerfCounters::EventName(event) << "_per_vertex " << PerfCounters::EventName(event) << "_per_edge";
+    output << std::endl;
+
+    for (const std::string& name : order)
+    {
+        Summary& summary = summaries[name];
+        output << name;
+
+        for (int i = 0; i < PERF_EVENT_COUNT; i++)
+        {
+            if (summary.events[i] == PERF_UNAVAILABLE)
+                output << " -";
+            else
+                output << " " << summary.events[i];
+        }
+
+        long long cycles = summary.events[PERF_CYCLES], instructions = summary.events[PERF_INSTRUCTIONS];
+        if (cycles > 0 && instructions != PERF_UNAVAILABLE)
+            output << " " << (double)instructions / cycles;
+        else
+            output << " -";
+
+        for (PerfEvent event : misses)
+        {
+            long long count = summary.events[event];
+
+            for (long long size : { vertices, edges })
+            {
+                if (count == PERF_UNAVAILABLE || size == 0)
+                    output << " -";
+                else
+                    output << " " << (double)count / size;
+            }
+        }
+
+        output << std::endl;
+    }
+}
+
+void Stats::WriteTrace(std::ostream& output)
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+
+    output << "{\"traceEvents\": [" << std::endl;
+
+    for (size_t i = 0; i < statsRecords.size(); i++)
+    {
+        const StatsRecord& record = statsRecords[i];
+
+        output << "  {\"name\": ";
+        WriteJsonString(output, record.name);
+        output << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << record.thread << std::fixed
+               << ", \"ts\": " << record.start << ", \"dur\": " << record.duration << ", \"args\": {";
+        output.unsetf(std::ios::floatfield);
+
+        for (int j = 0; j < STATS_COUNTER_COUNT; j++)
+            output << (j > 0 ? ", " : "") << "\"" << CounterName((StatsCounter)j) << "\": " << record.counters[j];
+
+        for (int j = 0; j < PERF_EVENT_COUNT && _hardwareCounters; j++)
+        {
+            if (record.events[j] != PERF_UNAVAILABLE)
+                output << ", \"" << PerfCounters::EventName((PerfEvent)j) << "\": " << record.events[j];
+        }
+
+        output << "}}" << (i + 1 < statsRecords.size() ? "," : "") << std::endl;
+    }
+
+    output << "], \"displayTimeUnit\": \"ms\"}" << std::endl;
+}
+
+void Stats::Clear()
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    statsRecords.clear();
+}
+
+StatsPhase::StatsPhase(std::string name)
+{
+    _name = name;
+
+    for (int i = 0; i < STATS_COUNTER_COUNT; i++)
+        _counters[i] = Stats::Get((StatsCounter)i);
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+        _events[i] = PERF_UNAVAILABLE;
+
+    if (Stats::HasHardwareCounters())
+        Stats::ReadHardwareCounters(_events);
+
+    _start = std::chrono::steady_clock::now();
+}
+
+StatsPhase::~StatsPhase()
+{
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    if (Stats::HasHardwareCounters())
+    {
+        long long events[PERF_EVENT_COUNT];
+        Stats::ReadHardwareCounters(events);
+
+        for (int i = 0; i < PERF_EVENT_COUNT; i++)
+            _events[i] = events[i] == PERF_UNAVAILABLE || _events[i] == PERF_UNAVAILABLE ? PERF_UNAVAILABLE : events[i] - _events[i];
+    }
+
+    for (int i = 0; i < STATS_COUNTER_COUNT; i++)
+        _counters[i] = Stats::Get((StatsCounter)i) - _counters[i];
+
+    Stats::RecordPhase(_name, _start, end, _counters, _events);
+}
+
+#endif
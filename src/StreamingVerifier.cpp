@@ -0,0 +1,188 @@
+#include <cstring>
+#include <algorithm>
+
+#include "StreamingVerifier.hpp"
+#include "GraphRunner.hpp"
+#include "GraphOrderer.hpp"
+#include "Stats.hpp"
+
+StreamingVerifier::StreamingVerifier(std::istream& input) : _input(input)
+{
+    _sortMethod = '\0';
+    _vertexCount = 0;
+    _adjacencyStart = -1;
+}
+
+template <typename Visit, typename Finish>
+void StreamingVerifier::ReadAdjacency(Visit visit, Finish finish)
+{
+    // The same variables as Graph::BuildFromIoStream, which keep their values when a read fails
+    int edgesCount = 0, id = 0;
+
+    for (int i = 0; i < _vertexCount; i++)
+    {
+        _input >> edgesCount;
+
+        for (int j = 0; j < edgesCount; j++)
+        {
+            _input >> id;
+            visit(i, id);
+
+            // The remaining reads of the line would only repeat the same neighbor
+            if (_input.fail())
+                break;
+        }
+
+        finish(i);
+    }
+}
+
+bool StreamingVerifier::ReadColors()
+{
+    STATS_PHASE("parse");
+
+    _input >> _sortMethod;
+
+    int verticesCount = 0;
+    _input >> verticesCount;
+
+    // Rejects the sort method as the graph constructor would
+    GraphOrderer orderer(_sortMethod);
+
+    _vertexCount = std::max(verticesCount, 0);
+    _adjacencyStart = _input.tellg();
+
+    if (_adjacencyStart == std::streampos(-1) && !_input.fail())
+        throw unseekable_input_exception();
+
+    STATS_ADD(STATS_VERTICES_READ, _vertexCount);
+
+    ReadAdjacency([this](int, int id) {
+        if (id < 0 || id >= _vertexCount)
+            throw element_not_found_exception();
+    }, [](int) {});
+
+    _colors.resize(_vertexCount);
+
+    int color = 0;
+    for (int i = 0; i < _vertexCount; i++)
+    {
+        _input >> color;
+        _colors[i] = color;
+    }
+
+    return _input.fail();
+}
+
+bool StreamingVerifier::CheckVertices()
+{
+    STATS_PHASE("is_greedy");
+
+    // A stream that failed before the adjacency lines fails again on every read of the second pass
+    _input.clear();
+    if (_adjacencyStart == std::streampos(-1))
+        _input.setstate(std::ios_base::failbit);
+    else
+        _input.seekg(_adjacencyStart);
+
+    // seen[c] is the last vertex that found a neighbor of color c. A vertex has at most V - 1 other
+    // neighbors, so a color above V + 1 is never greedy and needs no entry
+    std::vector<int> seen(_vertexCount + 2, -1);
+    int color = 0, bound = 0, missing = 0;
+    bool conflict = false, isGreedy = true;
+
+    auto start = [&](int i) {
+        color = _colors[i];
+        bound = color <= _vertexCount + 1 ? color : 0;
+        missing = std::max(bound - 1, 0);
+        conflict = false;
+    };
+
+    if (_vertexCount > 0)
+        start(0);
+
+    ReadAdjacency([&](int i, int id) {
+        int neighborColor = _colors[id];
+
+        // SetVertexColor only compares with the vertices that already have a color
+        conflict |= id < i && neighborColor == color;
+
+        if (neighborColor >= 1 && neighborColor < bound && seen[neighborColor] != i)
+        {
+            seen[neighborColor] = i;
+            missing--;
+        }
+    }, [&](int i) {
+        if (color < 0)
+            throw invalid_color_change_exception();
+
+        if (conflict)
+            throw unavailable_color_exception();
+
+        if (color != 1 && (bound < 2 || missing > 0))
+            isGreedy = false;
+
+        if (i + 1 < _vertexCount)
+            start(i + 1);
+    });
+
+    return isGreedy;
+}
+
+bool StreamingVerifier::Verify()
+{
+    bool failed = ReadColors();
+    bool isGreedy = CheckVertices();
+
+    if (failed)
+        throw malformed_input_exception();
+
+    return isGreedy;
+}
+
+Graph* StreamingVerifier::BuildOrderingGraph(MonotonicArena* arena)
+{
+    Graph* graph = new Graph(_sortMethod, arena);
+
+    for (int i = 0; i < _vertexCount; i++)
+        graph->CreateVertex(i);
+
+    graph->ReplaceColors(_colors);
+
+    return graph;
+}
+
+bool StreamingVerifier::Run(std::istream& input, OutputWriter& output, int firstCount)
+{
+    MonotonicArena arena;
+    Graph* graph = nullptr;
+
+    try
+    {
+        StreamingVerifier verifier(input);
+        bool isGreedy = verifier.Verify();
+
+        // Only a greedy answer has ordered vertices to write
+        if (isGreedy && firstCount != 0)
+            graph = verifier.BuildOrderingGraph(&arena);
+
+        GraphRunner::WriteAnswer(graph, isGreedy, output, firstCount);
+        delete graph;
+
+        return true;
+    }
+    catch(output_write_exception)
+    {
+        delete graph;
+        throw;
+    }
+    catch(...)
+    {
+        const char* message = GraphRunner::DescribeCurrentException();
+
+        output.WriteBytes(message, strlen(message));
+        output.WriteChar('\n');
+
+        return false;
+    }
+}
@@ -1,11 +1,15 @@
 #include "Vertex.hpp"
+#include "Stats.hpp"
 
-Vertex::Vertex(int id)
+Vertex::Vertex(int id, MonotonicArena* arena) : _adjacencyIndex(arena)
 {
     _id = id;
     _color = UNDEFINED_COLOR;
 
-    _adjacentVertices = new LinkedList<Vertex*>();
+    if (arena == nullptr)
+        _adjacentVertices = new LinkedList<Vertex*>();
+    else
+        _adjacentVertices = arena->Create<LinkedList<Vertex*>>(arena);
 }
 
 Vertex::~Vertex()
@@ -13,11 +17,6 @@ Vertex::~Vertex()
     delete _adjacentVertices;
 }
 
-int Vertex::GetId()
-{
-    return _id;
-}
-
 void Vertex::SetColor(int color)
 {
     if (color < 0 || _color != UNDEFINED_COLOR)
@@ -29,9 +28,9 @@ void Vertex::SetColor(int color)
     _color = color;
 }
 
-int Vertex::GetColor()
+void Vertex::ReplaceColor(int color)
 {
-    return _color;
+    _color = color;
 }
 
 void Vertex::AddAdjacentVertex(Vertex* vertex)
@@ -39,14 +38,33 @@ void Vertex::AddAdjacentVertex(Vertex* vertex)
     if (IsAdjacent(vertex))
         return;
 
+    AppendAdjacentVertex(vertex);
+}
+
+void Vertex::AppendAdjacentVertex(Vertex* vertex)
+{
     _adjacentVertices->Insert(vertex);
+    _adjacencyIndex.Insert(vertex->GetId());
+}
+
+void Vertex::ReserveAdjacency(int degree, int vertexCount)
+{
+    if (degree >= AdjacencyIndex::BitsetThreshold(vertexCount))
+        _adjacencyIndex.UseBitset(vertexCount);
+    else
+        _adjacencyIndex.Reserve(degree);
+}
+
+bool Vertex::HasDenseAdjacency()
+{
+    return _adjacencyIndex.IsBitset();
 }
 
 bool Vertex::HasAdjacentColor(int color)
 {
-    for(int i = 0; i < _adjacentVertices->Length(); i++)
+    for (Node<Vertex*>* node = _adjacentVertices->Empty() ? nullptr : _adjacentVertices->GetNode(0); node != nullptr; node = node->next)
     {
-        if (_adjacentVertices->Get(i)->GetColor() == color)
+        if (node->data->GetColor() == color)
             return true;
     }
 
@@ -55,7 +73,7 @@ bool Vertex::HasAdjacentColor(int color)
 
 bool Vertex::IsAdjacent(Vertex* vertex)
 {
-    return _adjacentVertices->Contains(vertex);
+    return _adjacencyIndex.Contains(vertex->GetId());
 }
 
 LinkedList<Vertex*>* Vertex::GetAdjacentVertices()
@@ -64,45 +82,42 @@ LinkedList<Vertex*>* Vertex::GetAdjacentVertices()
 }
 
 bool Vertex::IsGreedy()
+{
+    std::vector<int> seen;
+    return IsGreedy(seen, 0);
+}
+
+bool Vertex::IsGreedy(std::vector<int>& seen, int stamp)
 {
     if (_color == 1)
         return true;
 
-    if (_color == UNDEFINED_COLOR || _adjacentVertices->Empty())
+    if (_color < 1 || _adjacentVertices->Length() < _color - 1)
         return false;
 
-    unsigned int colorCount = _color - 1;    
+    if ((int)seen.size() < _color)
+        seen.resize(_color, -1);
 
-    if ((unsigned int)_adjacentVertices->Length() < colorCount)
-        return false;
+    int missing = _color - 1;
 
-    bool* expectedColors = new bool[colorCount];
-
-    for(int i = 0; i < _adjacentVertices->Length(); i++)
+    for (Node<Vertex*>* node = _adjacentVertices->Empty() ? nullptr : _adjacentVertices->GetNode(0); node != nullptr && missing > 0; node = node->next)
     {
-        Vertex* current = _adjacentVertices->Get(i);
+        int color = node->data->GetColor();
 
-        if (current->GetColor() == UNDEFINED_COLOR || current->GetColor() >= _color)
+        if (color < 1 || color >= _color || seen[color] == stamp)
             continue;
 
-        expectedColors[current->GetColor() - 1] = true;
+        seen[color] = stamp;
+        missing--;
     }
 
-    for(unsigned int i = 0; i < colorCount; i++)
-    {
-        if (!expectedColors[i])
-        {
-            delete[] expectedColors;
-            return false;
-        }
-    }
-
-    delete[] expectedColors;
-    return true;
+    return missing == 0;
 }
 
 bool Vertex::IsBiggerThan(Vertex* other)
 {
+    STATS_COUNT(STATS_COMPARISONS);
+
     if (other->_color == _color)
         return _id > other->_id;
 
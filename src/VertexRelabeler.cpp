@@ -0,0 +1,229 @@
+#include <cstdlib>
+#include <numeric>
+#include <algorithm>
+#include <unordered_map>
+
+#include "VertexRelabeler.hpp"
+
+VertexRelabeler::VertexRelabeler(LinkedList<Vertex*>* vertices)
+{
+    for (Node<Vertex*>* node = vertices->Empty() ? nullptr : vertices->GetNode(0); node != nullptr; node = node->next)
+        _vertices.push_back(node->data);
+
+    int count = (int)_vertices.size();
+
+    // Ids read from the input are exactly 0..n-1, so the position of a neighbor is usually found by its id
+    std::vector<int> positionById(count, -1);
+    bool denseIds = true;
+
+    for (int i = 0; i < count && denseIds; i++)
+    {
+        int id = _vertices[i]->GetId();
+
+        if (id < 0 || id >= count || positionById[id] != -1)
+            denseIds = false;
+        else
+            positionById[id] = i;
+    }
+
+    std::unordered_map<Vertex*, int> positionByVertex;
+    if (!denseIds)
+    {
+        positionByVertex.reserve(count);
+
+        for (int i = 0; i < count; i++)
+            positionByVertex[_vertices[i]] = i;
+    }
+
+    _offsets.assign(count + 1, 0);
+
+    for (int i = 0; i < count; i++)
+    {
+        LinkedList<Vertex*>* adjacentVertices = _vertices[i]->GetAdjacentVertices();
+
+        for (Node<Vertex*>* node = adjacentVertices->Empty() ? nullptr : adjacentVertices->GetNode(0); node != nullptr; node = node->next)
+            _neighbors.push_back(denseIds ? positionById[node->data->GetId()] : positionByVertex.at(node->data));
+
+        _offsets[i + 1] = _neighbors.size();
+    }
+}
+
+std::vector<int> VertexRelabeler::DegreeOrder(bool descending)
+{
+    std::vector<int> order(_vertices.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::stable_sort(order.begin(), order.end(), [&](int first, int second) {
+        int64_t firstDegree = _offsets[first + 1] - _offsets[first];
+        int64_t secondDegree = _offsets[second + 1] - _offsets[second];
+
+        return descending ? firstDegree > secondDegree : firstDegree < secondDegree;
+    });
+
+    return order;
+}
+
+std::vector<int> VertexRelabeler::BreadthFirstOrder(const std::vector<int>& starts, bool byDegree)
+{
+    std::vector<int> order;
+    order.reserve(_vertices.size());
+
+    std::vector<bool> visited(_vertices.size(), false);
+    std::vector<int> discovered;
+
+    for (int start : starts)
+    {
+        if (visited[start])
+            continue;
+
+        visited[start] = true;
+        order.push_back(start);
+
+        // The order itself is the queue: the vertices after the current one are the ones still to be expanded
+        for (size_t head = order.size() - 1; head < order.size(); head++)
+        {
+            int current = order[head];
+            discovered.clear();
+
+            for (int64_t i = _offsets[current]; i < _offsets[current + 1]; i++)
+            {
+                if (!visited[_neighbors[i]])
+                {
+                    visited[_neighbors[i]] = true;
+                    discovered.push_back(_neighbors[i]);
+                }
+            }
+
+            if (byDegree)
+            {
+                std::stable_sort(discovered.begin(), discovered.end(), [&](int first, int second) {
+                    return _offsets[first + 1] - _offsets[first] < _offsets[second + 1] - _offsets[second];
+                });
+            }
+
+            order.insert(order.end(), discovered.begin(), discovered.end());
+        }
+    }
+
+    return order;
+}
+
+std::vector<int> VertexRelabeler::ComputeOrder(RelabelOrder order)
+{
+    std::vector<int> current(_vertices.size());
+    std::iota(current.begin(), current.end(), 0);
+
+    switch (order)
+    {
+        case RELABEL_NONE:
+            return current;
+
+        case RELABEL_DEGREE:
+            return DegreeOrder(true);
+
+        case RELABEL_BFS:
+            return BreadthFirstOrder(current, false);
+
+        case RELABEL_RCM:
+        {
+            // Cuthill–McKee starts each component from a vertex of minimum degree, and the reversed order
+            // has the same bandwidth with less fill
+            std::vector<int> result = BreadthFirstOrder(DegreeOrder(false), true);
+            std::reverse(result.begin(), result.end());
+
+            return result;
+        }
+
+        default:
+            throw invalid_relabel_order_exception();
+    }
+}
+
+int64_t VertexRelabeler::Bandwidth(const std::vector<int>& order)
+{
+    std::vector<int> newPosition(_vertices.size());
+    for (size_t i = 0; i < order.size(); i++)
+        newPosition[order[i]] = (int)i;
+
+    int64_t bandwidth = 0;
+
+    for (size_t v = 0; v < _vertices.size(); v++)
+    {
+        for (int64_t i = _offsets[v]; i < _offsets[v + 1]; i++)
+            bandwidth = std::max(bandwidth, (int64_t)std::abs(newPosition[v] - newPosition[_neighbors[i]]));
+    }
+
+    return bandwidth;
+}
+
+LinkedList<Vertex*>* VertexRelabeler::Rebuild(const std::vector<int>& order, MonotonicArena* arena)
+{
+    LinkedList<Vertex*>* vertices = new LinkedList<Vertex*>(arena);
+    std::vector<Vertex*> copies(_vertices.size());
+
+    // The vertices are allocated together, so the colors read while scanning an adjacency list are close
+    // to each other, and then the adjacency lists, also in the new order
+    for (int position : order)
+    {
+        int id = _vertices[position]->GetId();
+        copies[position] = arena == nullptr ? new Vertex(id) : arena->Create<Vertex>(id, arena);
+    }
+
+    // The list keeps the original positions: sort methods that do not fully sort ('y') depend on them
+    for (Vertex* copy : copies)
+        vertices->Insert(copy);
+
+    for (int position : order)
+    {
+        copies[position]->ReserveAdjacency(_offsets[position + 1] - _offsets[position], (int)_vertices.size());
+
+        for (int64_t i = _offsets[position]; i < _offsets[position + 1]; i++)
+            copies[position]->AppendAdjacentVertex(copies[_neighbors[i]]);
+    }
+
+    // The colors are assigned in the original order, so SetColor checks exactly what it checked before
+    for (size_t position = 0; position < _vertices.size(); position++)
+    {
+        if (_vertices[position]->GetColor() != UNDEFINED_COLOR)
+            copies[position]->SetColor(_vertices[position]->GetColor());
+    }
+
+    return vertices;
+}
+
+RelabelOrder VertexRelabeler::ParseOrder(const std::string& name)
+{
+    if (name == "none")
+        return RELABEL_NONE;
+
+    if (name == "degree")
+        return RELABEL_DEGREE;
+
+    if (name == "bfs")
+        return RELABEL_BFS;
+
+    if (name == "rcm")
+        return RELABEL_RCM;
+
+    throw invalid_relabel_order_exception();
+}
+
+const char* VertexRelabeler::OrderName(RelabelOrder order)
+{
+    switch (order)
+    {
+        case RELABEL_NONE:
+            return "none";
+
+        case RELABEL_DEGREE:
+            return "degree";
+
+        case RELABEL_BFS:
+            return "bfs";
+
+        case RELABEL_RCM:
+            return "rcm";
+    }
+
+    throw invalid_relabel_order_exception();
+}
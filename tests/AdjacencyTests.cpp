@@ -0,0 +1,122 @@
+#include <set>
+#include <random>
+#include <sstream>
+
+#include "../third_party/doctest.h"
+#include "Graph.hpp"
+#include "GraphGenerator.hpp"
+#include "AdjacencyIndex.hpp"
+#include "MonotonicArena.hpp"
+#include "OutputWriter.hpp"
+
+TEST_CASE("Adjacency index finds the same ids as a set, with and without a bitset row")
+{
+    std::mt19937 random(3);
+    MonotonicArena arena(256);
+
+    for (MonotonicArena* indexArena : { (MonotonicArena*)nullptr, &arena })
+    {
+        AdjacencyIndex index(indexArena);
+        std::set<int> expected;
+
+        // Ascending runs, which the insertion gallops over, mixed with random ids and ids outside [0, 1000)
+        for (int i = 0; i < 600; i++)
+        {
+            int id = i % 3 == 0 ? (int)(random() % 1200) - 100 : i * 2;
+            if (expected.insert(id).second)
+                index.Insert(id);
+
+            if (i == 300)
+                index.UseBitset(1000);
+        }
+
+        CHECK(index.IsBitset());
+        CHECK(index.MemoryBytes() >= 1000 / 8);
+
+        for (int id = -150; id < 1500; id++)
+            CHECK(index.Contains(id) == (expected.count(id) == 1));
+    }
+}
+
+TEST_CASE("Hubs switch to a bitset row from a threshold that follows the graph size")
+{
+    CHECK(AdjacencyIndex::BitsetThreshold(10) == MIN_BITSET_DEGREE);
+    CHECK(AdjacencyIndex::BitsetThreshold(1 << 20) == (1 << 20) / BITSET_DEGREE_DIVISOR);
+
+    Graph* graph = new Graph('a');
+    Vertex* center = graph->CreateVertex(0);
+
+    for (int i = 1; i <= MIN_BITSET_DEGREE; i++)
+    {
+        CHECK_FALSE(center->HasDenseAdjacency());
+
+        Vertex* leaf = graph->CreateVertex(i);
+        graph->AddEdge(center, leaf);
+        graph->AddEdge(center, leaf);
+        graph->AddEdge(leaf, center);
+    }
+
+    CHECK(center->HasDenseAdjacency());
+    CHECK_FALSE(graph->GetVertex(1)->HasDenseAdjacency());
+    CHECK(graph->EdgeCount() == MIN_BITSET_DEGREE);
+
+    // Vertices created after the row was allocated are still found
+    Vertex* late = graph->CreateVertex(MIN_BITSET_DEGREE + 1);
+    CHECK_FALSE(center->IsAdjacent(late));
+    graph->AddEdge(center, late);
+    CHECK(center->IsAdjacent(late));
+
+    for (int i = 1; i <= MIN_BITSET_DEGREE; i++)
+    {
+        CHECK(center->IsAdjacent(graph->GetVertex(i)));
+        CHECK(graph->GetVertex(i)->IsAdjacent(center));
+    }
+
+    CHECK_FALSE(graph->GetVertex(1)->IsAdjacent(graph->GetVertex(2)));
+
+    delete graph;
+}
+
+TEST_CASE("Graphs built in every way agree on the adjacencies")
+{
+    GraphGenerator generator(DENSE, 600, 0, 4);
+
+    std::string text;
+    {
+        OutputWriter output(text);
+        generator.Write(output, 'a');
+    }
+
+    MonotonicArena arena;
+    std::istringstream input(text);
+
+    Graph* generated = generator.BuildGraph('a');
+    Graph* parsed = Graph::BuildFromIoStream(input, &arena);
+    Graph* relabeled = generator.BuildGraph('a');
+    relabeled->Relabel(RELABEL_DEGREE);
+
+    CHECK(parsed->EdgeCount() == generated->EdgeCount());
+    CHECK(relabeled->EdgeCount() == generated->EdgeCount());
+
+    int denseCount = 0;
+    for (int i = 0; i < generated->VertexCount(); i++)
+        denseCount += generated->GetVertex(i)->HasDenseAdjacency();
+
+    CHECK(denseCount > 0);
+
+    // The relabeled vertices keep their ids in another position, so they are compared through the parsed graph
+    for (int i = 0; i < relabeled->VertexCount(); i++)
+    {
+        Vertex* vertex = relabeled->GetVertex(i);
+        Vertex* original = parsed->GetVertex(vertex->GetId());
+
+        CHECK(vertex->HasDenseAdjacency() == original->HasDenseAdjacency());
+
+        for (int j = 0; j < 600; j += 7)
+            CHECK(vertex->IsAdjacent(parsed->GetVertex(j)) == original->IsAdjacent(generated->GetVertex(j)));
+    }
+
+    delete generated;
+    delete parsed;
+    delete relabeled;
+}
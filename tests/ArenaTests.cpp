@@ -0,0 +1,79 @@
+#include <string>
+#include <fstream>
+#include <cstdint>
+
+#include "../third_party/doctest.h"
+#include "Graph.hpp"
+#include "GraphRunner.hpp"
+#include "GraphGenerator.hpp"
+#include "MonotonicArena.hpp"
+#include "OutputWriter.hpp"
+
+TEST_CASE("Arena allocations are aligned and reset keeps the memory in a single block")
+{
+    MonotonicArena arena(64);
+
+    for (int i = 0; i < 100; i++)
+    {
+        CHECK((uintptr_t)arena.Allocate(3, 1) != 0);
+        CHECK((uintptr_t)arena.Allocate(sizeof(double), alignof(double)) % alignof(double) == 0);
+    }
+
+    char* large = (char*)arena.Allocate(10000);
+    large[9999] = 'x';
+
+    size_t reserved = arena.ReservedBytes();
+    CHECK(arena.UsedBytes() >= 100 * 11 + 10000);
+    CHECK(reserved >= arena.UsedBytes());
+
+    arena.Reset();
+    CHECK(arena.UsedBytes() == 0);
+    CHECK(arena.ReservedBytes() == reserved);
+
+    // The same allocations fit in the merged block without growing it
+    for (int i = 0; i < 100; i++)
+        arena.Allocate(sizeof(double), alignof(double));
+
+    arena.Allocate(10000);
+    CHECK(arena.ReservedBytes() == reserved);
+}
+
+TEST_CASE("Graphs in an arena give the same answers and reuse its memory")
+{
+    GraphGenerator generator(POWER_LAW, 400, 6, 5);
+    MonotonicArena arena(1024);
+
+    Graph* heap = generator.BuildGraph('a');
+    Graph* arenaGraph = generator.BuildGraph('a', &arena);
+
+    CHECK(arenaGraph->EdgeCount() == heap->EdgeCount());
+    CHECK(arenaGraph->IsGreedy() == heap->IsGreedy());
+    CHECK(arenaGraph->OrderedVertices() == heap->OrderedVertices());
+
+    delete heap;
+    delete arenaGraph;
+
+    size_t reserved = arena.ReservedBytes();
+    CHECK(arena.UsedBytes() == 0);
+
+    for (int i = 1; i <= 9; i++)
+    {
+        std::string path = "tests/Inputs/0" + std::to_string(i) + ".txt";
+        std::string expected, answer;
+
+        std::ifstream first(path), second(path);
+        {
+            OutputWriter output(expected);
+            GraphRunner::Run(first, output);
+        }
+        {
+            OutputWriter output(answer);
+            GraphRunner::Run(second, output, -1, &arena);
+        }
+
+        CHECK(answer == expected);
+        CHECK(arena.UsedBytes() == 0);
+    }
+
+    CHECK(arena.ReservedBytes() == reserved);
+}
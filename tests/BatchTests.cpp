@@ -0,0 +1,57 @@
+#include <string>
+#include <fstream>
+#include <algorithm>
+
+#include "../third_party/doctest.h"
+#include "BatchRunner.hpp"
+#include "GraphRunner.hpp"
+#include "OutputWriter.hpp"
+
+TEST_CASE("Batch answers every file like a single run, in the order of the paths")
+{
+    BatchRunner batch("tests/Inputs/0*.txt", 3);
+    REQUIRE(batch.FileCount() == 9);
+
+    batch.Run();
+
+    for (size_t i = 0; i < batch.FileCount(); i++)
+    {
+        const BatchJob& job = batch.GetJob(i);
+        CHECK(job.path == "tests/Inputs/0" + std::to_string(i + 1) + ".txt");
+
+        std::ifstream input(job.path);
+        std::string expected;
+        {
+            OutputWriter output(expected);
+            GraphRunner::Run(input, output);
+        }
+
+        CHECK(job.result == expected);
+    }
+
+    CHECK(batch.GetJob(4).result == "1 1 2 4 5 6 3 7 8 9 0\n");
+
+    std::string lines;
+    {
+        OutputWriter output(lines);
+        batch.WriteResults(output);
+    }
+
+    std::string firstLine = "tests/Inputs/01.txt: " + batch.GetJob(0).result;
+    CHECK(lines.compare(0, firstLine.size(), firstLine) == 0);
+    CHECK(std::count(lines.begin(), lines.end(), '\n') == 9);
+}
+
+TEST_CASE("Batch of a directory with a single worker and an empty pattern")
+{
+    BatchRunner batch("tests/Inputs", 1, 3);
+    CHECK(batch.FileCount() >= 19);
+
+    batch.Run();
+    CHECK(batch.StolenCount() == 0);
+
+    for (size_t i = 0; i < batch.FileCount(); i++)
+        CHECK_FALSE(batch.GetJob(i).result.empty());
+
+    CHECK_THROWS_AS(BatchRunner("tests/Inputs/*.missing", 2), empty_batch_exception);
+}
@@ -0,0 +1,161 @@
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include "../third_party/doctest.h"
+#include "Graph.hpp"
+#include "GraphRunner.hpp"
+#include "GraphGenerator.hpp"
+#include "MultiColoringVerifier.hpp"
+#include "OutputWriter.hpp"
+
+/**
+ * Writes a coloring as a color line of the input.
+ */
+std::string ColorLine(const std::vector<int>& colors)
+{
+    std::string line;
+
+    for (size_t i = 0; i < colors.size(); i++)
+        line += (i > 0 ? " " : "") + std::to_string(colors[i]);
+
+    return line + "\n";
+}
+
+TEST_CASE("Each coloring is answered as the graph with that coloring alone")
+{
+    GraphGenerator generator(POWER_LAW, 300, 6, 8);
+    std::vector<std::vector<int>> colorings;
+
+    for (int broken = 0; broken < 4; broken++)
+    {
+        GraphGenerator brokenGenerator = generator;
+        for (int i = 0; i < broken; i++)
+            brokenGenerator.BreakGreedy();
+
+        Graph* graph = brokenGenerator.BuildGraph('a');
+        std::vector<int> colors;
+
+        for (int v = 0; v < graph->VertexCount(); v++)
+            colors.push_back(graph->GetVertex(v)->GetColor());
+
+        colorings.push_back(colors);
+
+        // A color taken from a neighbor, a negative color, a color 0 and a color above the degree
+        Vertex* vertex = graph->GetVertex(7 + broken);
+        std::vector<int> changed = colors;
+        changed[vertex->GetId()] = vertex->GetAdjacentVertices()->Get(0)->GetColor();
+        colorings.push_back(changed);
+
+        changed = colors;
+        changed[250 - broken] = -1;
+        colorings.push_back(changed);
+
+        changed = colors;
+        changed[40 + broken] = 0;
+        colorings.push_back(changed);
+
+        changed = colors;
+        changed[vertex->GetId()] = vertex->GetAdjacentVertices()->Length() + 2;
+        colorings.push_back(changed);
+
+        delete graph;
+    }
+
+    std::string text;
+    {
+        OutputWriter output(text);
+        generator.Write(output, 'q');
+    }
+
+    // Only the adjacency lines are kept, without the color line at the end
+    std::string topology = text.substr(0, text.rfind('\n', text.size() - 2) + 1);
+
+    for (int firstCount : { -1, 0, 5 })
+    {
+        std::string expected, input = topology;
+        {
+            OutputWriter output(expected);
+
+            for (const std::vector<int>& colors : colorings)
+            {
+                std::istringstream single(topology + ColorLine(colors));
+                GraphRunner::Run(single, output, firstCount);
+                input += ColorLine(colors);
+            }
+        }
+
+        for (int blockSize : { 1, 3, 8, 64 })
+        {
+            std::string answers;
+            {
+                OutputWriter output(answers);
+                std::istringstream stream(input);
+
+                CHECK(MultiColoringVerifier::Run(stream, output, firstCount, blockSize) == (long)colorings.size());
+            }
+
+            CHECK(answers == expected);
+        }
+    }
+}
+
+TEST_CASE("Incomplete colorings end the answers with an error")
+{
+    std::string topology = "a\n3\n1 1\n2 0 2\n1 1\n";
+    std::string malformed = "A entrada terminou antes do grafo estar completo ou possui dados inválidos!\n";
+
+    auto run = [](const std::string& input) {
+        std::string answers;
+        {
+            OutputWriter output(answers);
+            std::istringstream stream(input);
+            MultiColoringVerifier::Run(stream, output, -1, 2);
+        }
+        return answers;
+    };
+
+    CHECK(run(topology + "1 2 1\n2 1 2\n1 2 1") == "1 0 2 1\n1 1 0 2\n1 0 2 1\n");
+    CHECK(run(topology + "1 2 1\n1 1 1\n2 1\n") == "1 0 2 1\n" "Coloração indisponível. Houve uma tentativa de atribuir uma cor indisponível a um vértice!\n" + malformed);
+    CHECK(run(topology + "1 2 1\n1 x 1\n") == "1 0 2 1\n" + malformed);
+    CHECK(run(topology) == malformed);
+    CHECK(run("a\n3\n1 1\n2 0\n") == malformed);
+}
+
+TEST_CASE("Blocks verify colorings loaded directly")
+{
+    GraphGenerator generator(GRID, 400, 4, 3);
+    Graph* graph = generator.BuildGraph('a');
+
+    std::string text;
+    {
+        OutputWriter output(text);
+        generator.Write(output, 'a');
+    }
+
+    std::istringstream stream(text);
+    Graph* topology = Graph::BuildTopologyFromIoStream(stream);
+    MultiColoringVerifier verifier(topology, 4);
+
+    std::vector<int> colors, shifted;
+    for (int v = 0; v < graph->VertexCount(); v++)
+    {
+        colors.push_back(graph->GetVertex(v)->GetColor());
+        shifted.push_back(colors.back() + 1);
+    }
+
+    verifier.LoadColoring(0, colors);
+    verifier.LoadColoring(1, shifted);
+    verifier.LoadColoring(2, std::vector<int>(colors.size(), 1));
+    verifier.LoadColoring(3, colors);
+
+    std::vector<ColoringVerdict> verdicts = verifier.VerifyBlock(4);
+    REQUIRE(verdicts.size() == 4);
+    CHECK(verdicts[0] == (graph->IsGreedy() ? COLORING_GREEDY : COLORING_NOT_GREEDY));
+    CHECK(verdicts[1] == COLORING_NOT_GREEDY);
+    CHECK(verdicts[2] == COLORING_UNAVAILABLE_COLOR);
+    CHECK(verdicts[3] == verdicts[0]);
+
+    delete graph;
+    delete topology;
+}
@@ -141,4 +141,64 @@ TEST_CASE("#13")
 TEST_CASE("#14")
 {
     BaseTest("14", true, "0 1 2 4 3");
-}
\ No newline at end of file
+}
+
+TEST_CASE("#05 first ordered vertices")
+{
+    RedirectInputStream("05");
+
+    Graph* graph = Graph::BuildFromIoStream();
+
+    CHECK(graph->FirstOrderedVertices(0) == "");
+    CHECK(graph->FirstOrderedVertices(4) == "1 2 4 5");
+    CHECK(graph->FirstOrderedVertices(50) == "1 2 4 5 6 3 7 8 9 0");
+
+    delete graph;
+    RestoreInputStream();
+}
+
+TEST_CASE("First ordered vertices are a prefix of the ordering, cached or not")
+{
+    // case_50 is sorted with 'y', which does not reach the full (color, id) order
+    for (std::string testCase : { "05", "case_50" })
+    {
+        for (int count : { 1, 11, 30, 100 })
+        {
+            RedirectInputStream(testCase);
+            Graph* graph = Graph::BuildFromIoStream();
+            RestoreInputStream();
+
+            std::string first = graph->FirstOrderedVertices(count);
+            std::string ordered = graph->OrderedVertices();
+
+            CHECK(first == graph->FirstOrderedVertices(count));
+            CHECK(ordered.compare(0, first.size(), first) == 0);
+            CHECK((first.size() == ordered.size() || ordered[first.size()] == ' '));
+
+            delete graph;
+        }
+    }
+}
+
+TEST_CASE("#06 ordering is cached and keeps the vertex positions")
+{
+    RedirectInputStream("06");
+
+    Graph* graph = Graph::BuildFromIoStream();
+
+    CHECK(graph->OrderedVertices() == "0 4 5 1 3 2");
+    CHECK(graph->OrderedVertices() == "0 4 5 1 3 2");
+    CHECK(graph->FirstOrderedVertices(3) == "0 4 5");
+
+    for (int i = 0; i < graph->VertexCount(); i++)
+    {
+        CHECK(graph->GetVertex(i)->GetId() == i);
+    }
+
+    graph->AddVertex(new Vertex(6));
+    graph->SetVertexColor(6, 1);
+    CHECK(graph->OrderedVertices() == "0 4 5 6 1 3 2");
+
+    delete graph;
+    RestoreInputStream();
+}
@@ -0,0 +1,105 @@
+#include <string>
+#include <sstream>
+
+#include "../third_party/doctest.h"
+#include "Graph.hpp"
+#include "GraphGenerator.hpp"
+#include "GraphRunner.hpp"
+#include "OutputWriter.hpp"
+
+std::string GeneratedText(GraphGenerator& generator, char sortOption)
+{
+    std::string text;
+    {
+        OutputWriter output(text);
+        generator.Write(output, sortOption);
+    }
+
+    return text;
+}
+
+TEST_CASE("Generated graphs have a greedy coloring in every model")
+{
+    for (GraphModel model : { ERDOS_RENYI, POWER_LAW, DENSE })
+    {
+        GraphGenerator generator(model, 500, 8, 7);
+        Graph* graph = generator.BuildGraph('n');
+
+        CHECK(graph->VertexCount() == 500);
+        CHECK(graph->EdgeCount() == generator.EdgeCount());
+        CHECK(generator.ColorCount() > 1);
+        CHECK(graph->IsGreedy());
+
+        delete graph;
+    }
+
+    CHECK(GraphGenerator(DENSE, 200, 0, 1).EdgeCount() > 200 * 199 / 2 / 8);
+    CHECK(GraphGenerator(POWER_LAW, 200, 6, 1).EdgeCount() == 6 + (200 - 4) * 3);
+}
+
+TEST_CASE("Generated text is deterministic and builds the same graph")
+{
+    GraphGenerator first(ERDOS_RENYI, 300, 5, 42);
+    GraphGenerator second(ERDOS_RENYI, 300, 5, 42);
+    GraphGenerator other(ERDOS_RENYI, 300, 5, 43);
+
+    std::string text = GeneratedText(first, 'm');
+    CHECK(text == GeneratedText(second, 'm'));
+    CHECK(text != GeneratedText(other, 'm'));
+
+    std::istringstream input(text);
+    Graph* parsed = Graph::BuildFromIoStream(input);
+    Graph* built = first.BuildGraph('m');
+
+    CHECK(parsed->EdgeCount() == built->EdgeCount());
+    CHECK(parsed->IsGreedy());
+    CHECK(parsed->OrderedVertices() == built->OrderedVertices());
+
+    delete parsed;
+    delete built;
+
+    CHECK(GraphGenerator::ParseModel(GraphGenerator::ModelName(POWER_LAW)) == POWER_LAW);
+    CHECK_THROWS_AS(GraphGenerator::ParseModel("lattice"), invalid_graph_model_exception);
+    CHECK_THROWS_AS(GraphGenerator(ERDOS_RENYI, 0, 4, 1), invalid_graph_model_exception);
+}
+
+TEST_CASE("Expected output matches the answer of the program for greedy and broken colorings")
+{
+    for (bool broken : { false, true })
+    {
+        GraphGenerator generator(POWER_LAW, 200, 6, 9);
+
+        if (broken)
+        {
+            int vertex = generator.BreakGreedy();
+            CHECK(generator.GetColor(vertex) > 1);
+        }
+
+        CHECK(generator.IsGreedyColoring() == !broken);
+
+        // Every sort method, including the ones that do not reach the full (color, id) order ('y')
+        for (char sortOption : std::string(SORT_OPTIONS) + AUTO_ORDERER_OPTION)
+        {
+            for (int firstCount : { -1, 5 })
+            {
+                std::string expected;
+                {
+                    OutputWriter output(expected);
+                    generator.WriteExpected(output, sortOption, firstCount);
+                }
+
+                std::istringstream input(GeneratedText(generator, sortOption));
+                Graph* graph = Graph::BuildFromIoStream(input);
+
+                std::string answer;
+                {
+                    OutputWriter output(answer);
+                    GraphRunner::WriteAnswer(graph, graph->IsGreedy(), output, firstCount);
+                }
+
+                CHECK(answer == expected);
+                delete graph;
+            }
+        }
+    }
+}
@@ -0,0 +1,558 @@
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include "../third_party/doctest.h"
+#include "Graph.hpp"
+#include "GraphRunner.hpp"
+#include "GraphOrderer.hpp"
+#include "PackedKeySorter.hpp"
+#include "OrderedVertexStream.hpp"
+#include "ExternalSorter.hpp"
+#include "OrdererEngine.hpp"
+#include "Stats.hpp"
+
+#ifndef GRAPH_STATS
+
+// Allocations made with new while the tracking is on (see the external orderer memory test). With
+// GRAPH_STATS, new is replaced by Stats and the test counts the allocations through it instead
+static bool trackAllocations = false;
+static size_t largestAllocation = 0;
+static size_t allocatedBytes = 0;
+
+void* operator new(size_t size)
+{
+    if (trackAllocations)
+    {
+        largestAllocation = std::max(largestAllocation, size);
+        allocatedBytes += size;
+    }
+
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+#endif
+
+LinkedList<Vertex*>* BuildRandomVertices(int count, int colors, unsigned int seed)
+{
+    LinkedList<Vertex*>* list = new LinkedList<Vertex*>();
+    std::srand(seed);
+
+    for (int i = 0; i < count; i++)
+    {
+        Vertex* vertex = new Vertex((i * 7919) % count);
+        vertex->SetColor(std::rand() % colors + 1);
+        list->Insert(vertex);
+    }
+
+    return list;
+}
+
+void DeleteVertices(LinkedList<Vertex*>* list)
+{
+    for (int i = 0; i < list->Length(); i++)
+    {
+        delete list->Get(i);
+    }
+
+    delete list;
+}
+
+bool IsOrdered(LinkedList<Vertex*>* list)
+{
+    for (int i = 1; i < list->Length(); i++)
+    {
+        if (list->Get(i - 1)->IsBiggerThan(list->Get(i)))
+            return false;
+    }
+
+    return true;
+}
+
+void OrdererTest(char option, int count, int colors)
+{
+    LinkedList<Vertex*>* list = BuildRandomVertices(count, colors, count + colors);
+    GraphOrderer orderer(option);
+
+    orderer.Sort(list);
+
+    CHECK(list->Length() == count);
+    CHECK(IsOrdered(list));
+
+    DeleteVertices(list);
+}
+
+TEST_CASE("Orderer 'l' sorts random vertices")
+{
+    OrdererTest('l', 1, 1);
+    OrdererTest('l', 2, 2);
+    OrdererTest('l', 97, 5);
+    OrdererTest('l', 1000, 30);
+}
+
+TEST_CASE("Orderer 'l' keeps the list nodes")
+{
+    LinkedList<Vertex*>* list = BuildRandomVertices(50, 4, 3);
+
+    Node<Vertex*>** nodes = new Node<Vertex*>*[50];
+    Vertex** contents = new Vertex*[50];
+    for (int i = 0; i < 50; i++)
+    {
+        nodes[i] = list->GetNode(i);
+        contents[i] = nodes[i]->data;
+    }
+
+    GraphOrderer orderer('l');
+    orderer.Sort(list);
+
+    CHECK(IsOrdered(list));
+    CHECK(list->GetNode(0)->previous == nullptr);
+    CHECK(list->GetNode(49)->next == nullptr);
+    CHECK(list->Last() == list->Get(49));
+
+    for (int i = 0; i < 50; i++)
+    {
+        CHECK(nodes[i]->data == contents[i]);
+    }
+
+    delete[] nodes;
+    delete[] contents;
+    DeleteVertices(list);
+}
+
+TEST_CASE("Orderer 'v' sorts random vertices")
+{
+    OrdererTest('v', 1, 1);
+    OrdererTest('v', 17, 3);
+    OrdererTest('v', 97, 5);
+    OrdererTest('v', 5000, 40);
+}
+
+void PackedKeyTest(void (*sort)(long long*, int), int length, int range)
+{
+    long long* keys = new long long[length];
+    long long* expected = new long long[length];
+
+    std::srand(length);
+    for (int i = 0; i < length; i++)
+    {
+        keys[i] = ((long long)(std::rand() % range) << 32) | (std::rand() % range);
+        expected[i] = keys[i];
+    }
+
+    std::sort(expected, expected + length);
+    sort(keys, length);
+
+    bool equal = true;
+    for (int i = 0; i < length; i++)
+    {
+        equal = equal && keys[i] == expected[i];
+    }
+    CHECK(equal);
+
+    delete[] keys;
+    delete[] expected;
+}
+
+TEST_CASE("Packed keys are sorted by the scalar and AVX2 implementations")
+{
+    int lengths[] = { 0, 1, 3, 4, 15, 16, 17, 64, 1001, 20000 };
+
+    for (int length : lengths)
+    {
+        PackedKeyTest(&PackedKeySorter::SortScalar, length, 1000);
+        PackedKeyTest(&PackedKeySorter::SortScalar, length, 2);
+
+        if (PackedKeySorter::HasAvx2())
+        {
+            PackedKeyTest(&PackedKeySorter::SortAvx2, length, 1000);
+            PackedKeyTest(&PackedKeySorter::SortAvx2, length, 2);
+        }
+    }
+}
+
+TEST_CASE("Orderer 'n' sorts random vertices")
+{
+    OrdererTest('n', 1, 1);
+    OrdererTest('n', 17, 3);
+    OrdererTest('n', 129, 5);
+    OrdererTest('n', 5000, 40);
+}
+
+TEST_CASE("Orderer 'n' handles sorted and reversed inputs")
+{
+    int length = 100000;
+    LinkedList<Vertex*>* sorted = new LinkedList<Vertex*>();
+    LinkedList<Vertex*>* reversed = new LinkedList<Vertex*>();
+
+    for (int i = 0; i < length; i++)
+    {
+        Vertex* vertex = new Vertex(i);
+        vertex->SetColor(i / 100 + 1);
+        sorted->Insert(vertex);
+
+        vertex = new Vertex(length - i - 1);
+        vertex->SetColor((length - i - 1) / 100 + 1);
+        reversed->Insert(vertex);
+    }
+
+    GraphOrderer orderer('n');
+    orderer.Sort(sorted);
+    orderer.Sort(reversed);
+
+    CHECK(IsOrdered(sorted));
+    CHECK(IsOrdered(reversed));
+
+    DeleteVertices(sorted);
+    DeleteVertices(reversed);
+}
+
+TEST_CASE("Orderer 't' sorts random vertices")
+{
+    OrdererTest('t', 1, 1);
+    OrdererTest('t', 33, 3);
+    OrdererTest('t', 129, 5);
+    OrdererTest('t', 5000, 40);
+    OrdererTest('t', 20000, 3);
+}
+
+TEST_CASE("Orderer 't' sorts nearly sorted vertices")
+{
+    int length = 50000;
+    LinkedList<Vertex*>* list = new LinkedList<Vertex*>();
+
+    for (int i = 0; i < length; i++)
+    {
+        // Vertices grouped by color, with a few of them out of place
+        int color = i % 997 == 0 ? (i * 31) % 50 + 1 : i / 1000 + 1;
+
+        Vertex* vertex = new Vertex(i % 2 == 0 ? i : length - i);
+        vertex->SetColor(color);
+        list->Insert(vertex);
+    }
+
+    GraphOrderer orderer('t');
+    orderer.Sort(list);
+
+    CHECK(IsOrdered(list));
+
+    DeleteVertices(list);
+}
+
+TEST_CASE("First vertices are selected in order without sorting the list")
+{
+    int counts[] = { 0, 1, 5, 16, 17, 300, 999, 1000, 1500 };
+
+    for (int count : counts)
+    {
+        LinkedList<Vertex*>* list = BuildRandomVertices(1000, 20, 11);
+        LinkedList<Vertex*>* sorted = BuildRandomVertices(1000, 20, 11);
+        GraphOrderer('n').Sort(sorted);
+
+        Vertex** first = new Vertex*[count];
+        int selected = GraphOrderer::SelectFirst(list, count, first);
+
+        CHECK(selected == (count < 1000 ? count : 1000));
+        for (int i = 0; i < selected; i++)
+        {
+            CHECK(first[i]->GetId() == sorted->Get(i)->GetId());
+        }
+
+        delete[] first;
+        DeleteVertices(list);
+        DeleteVertices(sorted);
+    }
+}
+
+TEST_CASE("Ordered vertex stream yields every vertex in order")
+{
+    LinkedList<Vertex*>* list = BuildRandomVertices(777, 9, 5);
+    LinkedList<Vertex*>* sorted = BuildRandomVertices(777, 9, 5);
+    GraphOrderer('n').Sort(sorted);
+
+    OrderedVertexStream stream(list);
+    CHECK(stream.Remaining() == 777);
+
+    for (int i = 0; i < 777; i++)
+    {
+        REQUIRE(stream.HasNext());
+        CHECK(stream.Next()->GetId() == sorted->Get(i)->GetId());
+    }
+
+    CHECK_FALSE(stream.HasNext());
+    CHECK_THROWS_AS(stream.Next(), stream_exhausted_exception);
+
+    DeleteVertices(list);
+    DeleteVertices(sorted);
+}
+
+TEST_CASE("Orderer 'a' chooses a method from the list characteristics")
+{
+    GraphOrderer orderer('a');
+
+    LinkedList<Vertex*>* small = BuildRandomVertices(10, 3, 1);
+    orderer.Sort(small);
+    CHECK(IsOrdered(small));
+    CHECK(orderer.GetChosenOption() == 'i');
+    CHECK_FALSE(orderer.GetChoiceReason().empty());
+
+    LinkedList<Vertex*>* sorted = BuildRandomVertices(5000, 40, 2);
+    GraphOrderer('n').Sort(sorted);
+    orderer.Sort(sorted);
+    CHECK(IsOrdered(sorted));
+    CHECK(orderer.GetChosenOption() == 't');
+
+    LinkedList<Vertex*>* random = BuildRandomVertices(5000, 40, 3);
+    orderer.Sort(random);
+    CHECK(IsOrdered(random));
+    CHECK(orderer.GetChosenOption() == (PackedKeySorter::HasAvx2() ? 'v' : 'n'));
+
+    CHECK(GraphOrderer('q').GetChoiceReason().empty());
+
+    DeleteVertices(small);
+    DeleteVertices(sorted);
+    DeleteVertices(random);
+}
+
+TEST_CASE("Orderer 'e' sorts random vertices")
+{
+    OrdererTest('e', 1, 1);
+    OrdererTest('e', 97, 5);
+    OrdererTest('e', 5000, 40);
+
+    GraphOrderer::SetExternalMemoryBudget(100 * sizeof(SortRecord));
+    OrdererTest('e', 5000, 40);
+    GraphOrderer::SetExternalMemoryBudget(DEFAULT_EXTERNAL_MEMORY_BUDGET);
+}
+
+TEST_CASE("Orderer 'e' writes the ordered vertices within the memory budget")
+{
+    const int count = 100000;
+    Graph graph('e');
+
+    std::vector<int> colors(count);
+    std::vector<std::pair<int, int>> expected(count);
+    std::srand(17);
+
+    for (int i = 0; i < count; i++)
+    {
+        graph.CreateVertex(i);
+        colors[i] = std::rand() % 50 + 1;
+        expected[i] = { colors[i], i };
+    }
+    graph.ReplaceColors(colors);
+    std::sort(expected.begin(), expected.end());
+
+    FILE* file = tmpfile();
+    REQUIRE(file != nullptr);
+
+    GraphOrderer::SetExternalMemoryBudget(1024 * sizeof(SortRecord));
+    {
+        OutputWriter writer(fileno(file));
+
+        // Neither a sorted copy of the list nor an array of all the vertices may be allocated
+#ifdef GRAPH_STATS
+        long long allocations = Stats::Get(STATS_ALLOCATIONS);
+        graph.WriteOrderedVertices(writer);
+        CHECK(Stats::Get(STATS_ALLOCATIONS) - allocations < count / 10);
+#else
+        largestAllocation = 0;
+        allocatedBytes = 0;
+        trackAllocations = true;
+        graph.WriteOrderedVertices(writer);
+        trackAllocations = false;
+
+        CHECK(largestAllocation < count * sizeof(Vertex*));
+        CHECK(allocatedBytes < count * sizeof(Vertex*));
+#endif
+    }
+    GraphOrderer::SetExternalMemoryBudget(DEFAULT_EXTERNAL_MEMORY_BUDGET);
+
+    rewind(file);
+    int id = 0;
+    for (int i = 0; i < count; i++)
+    {
+        REQUIRE(fscanf(file, "%d", &id) == 1);
+        CHECK(id == expected[i].second);
+    }
+    CHECK(fscanf(file, "%d", &id) == EOF);
+
+    fclose(file);
+}
+
+TEST_CASE("External sorter merges spilled runs in (color, id) order")
+{
+    ExternalSorter sorter(64 * sizeof(SortRecord));
+    LinkedList<Vertex*>* sorted = BuildRandomVertices(3000, 25, 8);
+    LinkedList<Vertex*>* list = BuildRandomVertices(3000, 25, 8);
+
+    for (int i = 0; i < list->Length(); i++)
+    {
+        sorter.Add({ list->Get(i)->GetColor(), list->Get(i)->GetId(), list->Get(i) });
+    }
+    GraphOrderer('n').Sort(sorted);
+
+    sorter.Finish();
+    CHECK(sorter.MergePassCount() == 1);
+    CHECK(sorter.RunCount() > 1);
+    CHECK(sorter.RunCount() <= EXTERNAL_MERGE_FAN_IN);
+
+    SortRecord record;
+    for (int i = 0; i < sorted->Length(); i++)
+    {
+        REQUIRE(sorter.Next(record));
+        CHECK(record.id == sorted->Get(i)->GetId());
+        CHECK(record.vertex->GetId() == record.id);
+    }
+    CHECK_FALSE(sorter.Next(record));
+
+    DeleteVertices(list);
+    DeleteVertices(sorted);
+}
+
+/**
+ * Lowers the limit of open files so that no other file can be opened, and returns the previous limit.
+ */
+struct rlimit ExhaustFileDescriptors()
+{
+    struct rlimit previous;
+    getrlimit(RLIMIT_NOFILE, &previous);
+
+    // The lowest free descriptor is the number of descriptors in use when they are consecutive
+    int lowest = dup(0);
+    close(lowest);
+
+    struct rlimit exhausted = previous;
+    exhausted.rlim_cur = lowest;
+    setrlimit(RLIMIT_NOFILE, &exhausted);
+
+    return previous;
+}
+
+TEST_CASE("External sorter merges in passes with two temporary files")
+{
+    const int count = 50000;
+    std::vector<std::pair<int, int>> expected(count);
+    std::srand(29);
+
+    // Two descriptors above the ones in use: the temporary files of the passes and nothing else
+    struct rlimit previous = ExhaustFileDescriptors();
+    struct rlimit limited;
+    getrlimit(RLIMIT_NOFILE, &limited);
+    limited.rlim_cur += 2;
+    setrlimit(RLIMIT_NOFILE, &limited);
+
+    {
+        ExternalSorter sorter(64 * sizeof(SortRecord));
+
+        for (int i = 0; i < count; i++)
+        {
+            expected[i] = { std::rand() % 300 + 1, i };
+            sorter.Add({ expected[i].first, expected[i].second, nullptr });
+        }
+        std::sort(expected.begin(), expected.end());
+
+        sorter.Finish();
+        CHECK(sorter.MergePassCount() >= 2);
+        CHECK(sorter.RunCount() <= EXTERNAL_MERGE_FAN_IN);
+
+        SortRecord record;
+        for (int i = 0; i < count; i++)
+        {
+            REQUIRE(sorter.Next(record));
+            CHECK(record.color == expected[i].first);
+            CHECK(record.id == expected[i].second);
+        }
+        CHECK_FALSE(sorter.Next(record));
+    }
+
+    setrlimit(RLIMIT_NOFILE, &previous);
+}
+
+TEST_CASE("Orderer 'e' writes nothing when its temporary files fail")
+{
+    Graph graph('e');
+    std::vector<int> colors(5000);
+
+    for (int i = 0; i < 5000; i++)
+    {
+        graph.CreateVertex(i);
+        colors[i] = i % 7 + 1;
+    }
+    graph.ReplaceColors(colors);
+
+    GraphOrderer::SetExternalMemoryBudget(100 * sizeof(SortRecord));
+    struct rlimit previous = ExhaustFileDescriptors();
+
+    std::string answer;
+    {
+        OutputWriter output(answer);
+        CHECK_THROWS_AS(GraphRunner::WriteAnswer(&graph, true, output), external_storage_exception);
+    }
+
+    setrlimit(RLIMIT_NOFILE, &previous);
+    GraphOrderer::SetExternalMemoryBudget(DEFAULT_EXTERNAL_MEMORY_BUDGET);
+
+    // Not even the verdict was written before the failure
+    CHECK(answer.empty());
+}
+
+TEST_CASE("Orderer engine sorts any item type with the same results")
+{
+    // Keys keep the (color, id) order, negative ids included
+    Vertex negative(-5), zero(0), other(3);
+    negative.SetColor(2);
+    zero.SetColor(1);
+    other.SetColor(2);
+
+    VertexKey keyOf;
+    CHECK(keyOf(&zero) < keyOf(&negative));
+    CHECK(keyOf(&negative) < keyOf(&other));
+
+    LinkedList<Vertex*>* list = BuildRandomVertices(700, 6, 42);
+    Vertex** vertices = new Vertex*[list->Length()];
+    KeyedVertex* keyed = new KeyedVertex[list->Length()];
+
+    typedef OrdererEngine<Vertex*, VertexKey> VertexEngine;
+    typedef OrdererEngine<KeyedVertex, StoredKey> KeyedEngine;
+
+    std::pair<void (*)(Vertex**, int), void (*)(KeyedVertex*, int)> sorts[] = {
+        { &VertexEngine::BubbleSort, &KeyedEngine::BubbleSort },
+        { &VertexEngine::QuickSort, &KeyedEngine::QuickSort },
+        { &VertexEngine::HeapSort, &KeyedEngine::HeapSort },
+        { &VertexEngine::CustomSort, &KeyedEngine::CustomSort },
+        { &VertexEngine::TimSort, &KeyedEngine::TimSort }
+    };
+
+    for (auto& sort : sorts)
+    {
+        for (int i = 0; i < list->Length(); i++)
+        {
+            vertices[i] = list->Get(i);
+            keyed[i] = { keyOf(vertices[i]), vertices[i] };
+        }
+
+        sort.first(vertices, list->Length());
+        sort.second(keyed, list->Length());
+
+        for (int i = 0; i < list->Length(); i++)
+            CHECK(vertices[i] == keyed[i].vertex);
+    }
+
+    delete[] vertices;
+    delete[] keyed;
+    DeleteVertices(list);
+}
@@ -0,0 +1,162 @@
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <string>
+#include <fstream>
+#include <iostream>
+
+#include "../third_party/doctest.h"
+#include "Graph.hpp"
+#include "OutputWriter.hpp"
+#include "BinaryPermutation.hpp"
+
+std::string ReadWholeFile(FILE* file)
+{
+    std::string content;
+    char buffer[4096];
+
+    rewind(file);
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        content.append(buffer, read);
+    }
+
+    return content;
+}
+
+Graph* BuildGraphFromFile(std::string testCase)
+{
+    std::ifstream input("tests//Inputs//" + testCase + ".txt");
+    REQUIRE(input.is_open());
+
+    std::streambuf* original = std::cin.rdbuf(input.rdbuf());
+    Graph* graph = Graph::BuildFromIoStream();
+    std::cin.rdbuf(original);
+
+    return graph;
+}
+
+TEST_CASE("Output writer formats numbers through a small buffer")
+{
+    FILE* file = tmpfile();
+    REQUIRE(file != nullptr);
+
+    {
+        OutputWriter writer(fileno(file), 8);
+
+        writer.WriteInt(0);
+        writer.WriteChar(' ');
+        writer.WriteInt(-1234567890123LL);
+        writer.WriteChar(' ');
+        writer.WriteBytes("a long sequence of bytes", 24);
+        writer.WriteInt(42);
+    }
+
+    CHECK(ReadWholeFile(file) == "0 -1234567890123 a long sequence of bytes42");
+    fclose(file);
+}
+
+TEST_CASE("Ordered vertices written to a buffer match the string version")
+{
+    const char* testCases[] = { "05", "big", "disc" };
+
+    for (const char* testCase : testCases)
+    {
+        Graph* graph = BuildGraphFromFile(testCase);
+        FILE* file = tmpfile();
+        REQUIRE(file != nullptr);
+
+        {
+            OutputWriter writer(fileno(file), 64);
+            graph->WriteOrderedVertices(writer);
+            writer.WriteChar('|');
+            graph->WriteOrderedVertices(writer, 3);
+        }
+
+        CHECK(ReadWholeFile(file) == graph->OrderedVertices() + "|" + graph->FirstOrderedVertices(3));
+
+        fclose(file);
+        delete graph;
+    }
+}
+
+TEST_CASE("Binary permutation round trip through a writer and a mapped file")
+{
+    Graph* graph = BuildGraphFromFile("05");
+    bool isGreedy = graph->IsGreedy();
+    REQUIRE(isGreedy);
+
+    char path[] = "/tmp/permutationXXXXXX";
+    int mapped = mkstemp(path);
+    REQUIRE(mapped >= 0);
+    close(mapped);
+
+    // The first ids are written before the ordering is cached, so they are selected without sorting
+    BinaryPermutation::WriteMapped(path, isGreedy, graph, 4);
+    FILE* mappedFile = fopen(path, "rb");
+    REQUIRE(mappedFile != nullptr);
+    std::string writtenMapped = ReadWholeFile(mappedFile);
+    fclose(mappedFile);
+    unlink(path);
+
+    FILE* file = tmpfile();
+    REQUIRE(file != nullptr);
+    {
+        OutputWriter writer(fileno(file));
+        BinaryPermutation::Write(writer, isGreedy, graph);
+    }
+    std::string written = ReadWholeFile(file);
+    fclose(file);
+
+    CHECK(written.size() == BinaryPermutation::Size(10));
+    CHECK(writtenMapped.size() == BinaryPermutation::Size(4));
+    CHECK(written.compare(0, 4, "GRDY") == 0);
+
+    bool readGreedy;
+    int count;
+    int* ids = BinaryPermutation::Read(written.data(), written.size(), readGreedy, count);
+    int* firstIds = BinaryPermutation::Read(writtenMapped.data(), writtenMapped.size(), readGreedy, count);
+
+    CHECK(readGreedy);
+    CHECK(count == 4);
+
+    std::string text = "";
+    for (int i = 0; i < 10; i++)
+    {
+        text += (i > 0 ? " " : "") + std::to_string(ids[i]);
+    }
+    CHECK(text == graph->OrderedVertices());
+
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK(firstIds[i] == ids[i]);
+    }
+
+    CHECK_THROWS_AS(BinaryPermutation::Read(written.data(), 15, readGreedy, count), invalid_binary_permutation_exception);
+
+    delete[] ids;
+    delete[] firstIds;
+    delete graph;
+}
+
+TEST_CASE("Binary permutation of a non greedy coloring has no ids")
+{
+    FILE* file = tmpfile();
+    REQUIRE(file != nullptr);
+    {
+        OutputWriter writer(fileno(file));
+        BinaryPermutation::Write(writer, false, nullptr);
+    }
+    std::string written = ReadWholeFile(file);
+    fclose(file);
+
+    bool readGreedy = true;
+    int count = -1;
+    int* ids = BinaryPermutation::Read(written.data(), written.size(), readGreedy, count);
+
+    CHECK_FALSE(readGreedy);
+    CHECK(count == 0);
+
+    delete[] ids;
+}
@@ -0,0 +1,91 @@
+#include <string>
+#include <thread>
+#include <sstream>
+#include <fstream>
+
+#include "../third_party/doctest.h"
+#include "SpscQueue.hpp"
+#include "GraphRunner.hpp"
+#include "GraphPipeline.hpp"
+#include "OutputWriter.hpp"
+
+TEST_CASE("Lock-free queue keeps the order and refuses items when full")
+{
+    SpscQueue<int> queue(3);
+    REQUIRE(queue.Capacity() == 4);
+
+    for (int i = 0; i < 4; i++)
+        CHECK(queue.TryPush(i));
+
+    CHECK_FALSE(queue.TryPush(4));
+
+    int item = -1;
+    CHECK(queue.TryPop(item));
+    CHECK(item == 0);
+    CHECK(queue.TryPush(4));
+
+    std::thread producer([&queue] {
+        for (int i = 5; i < 100000; i++)
+        {
+            while (!queue.TryPush(i))
+                std::this_thread::yield();
+        }
+    });
+
+    bool ordered = true;
+    for (int expected = 1; expected < 100000; expected++)
+    {
+        while (!queue.TryPop(item))
+            std::this_thread::yield();
+
+        ordered = ordered && item == expected;
+    }
+
+    producer.join();
+
+    CHECK(ordered);
+    CHECK(queue.Empty());
+}
+
+TEST_CASE("Pipeline answers a sequence of graphs in order, like one run per graph")
+{
+    std::string content, expected, first;
+    {
+        OutputWriter output(expected);
+
+        for (std::string testCase : { "05", "02", "big", "03", "06", "10" })
+        {
+            std::ifstream file("tests//Inputs//" + testCase + ".txt");
+            REQUIRE(file.is_open());
+
+            std::stringstream graph;
+            graph << file.rdbuf();
+            content += graph.str() + "\n";
+            if (first.empty())
+                first = graph.str() + "\n";
+
+            GraphRunner::Run(graph, output);
+        }
+    }
+
+    for (size_t depth : { 1, 4 })
+    {
+        std::stringstream input(content);
+        std::string answers;
+        {
+            OutputWriter output(answers, 64);
+            CHECK(GraphPipeline(input, output, -1, depth).Run() == 6);
+        }
+
+        CHECK(answers == expected);
+    }
+
+    std::stringstream malformed(first + "x 1\n0\n1\n" + content);
+    std::string answers;
+    {
+        OutputWriter output(answers);
+        CHECK(GraphPipeline(malformed, output, 2).Run() == 2);
+    }
+
+    CHECK(answers == "1 1 2\nO método de ordenação escolhido é inválido!\n");
+}
@@ -0,0 +1,133 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <sstream>
+
+#include "../third_party/doctest.h"
+#include "Graph.hpp"
+#include "GraphGenerator.hpp"
+#include "VertexRelabeler.hpp"
+#include "MonotonicArena.hpp"
+
+TEST_CASE("Reverse Cuthill-McKee recovers a path with scrambled ids")
+{
+    // Path 0 - 5 - 2 - 7 - 4 - 1 - 6 - 3, written in the input format
+    int path[] = { 0, 5, 2, 7, 4, 1, 6, 3 };
+    std::string adjacencies[8];
+
+    for (int i = 0; i < 8; i++)
+    {
+        std::string neighbors;
+        int count = 0;
+
+        if (i > 0)
+        {
+            neighbors += " " + std::to_string(path[i - 1]);
+            count++;
+        }
+
+        if (i < 7)
+        {
+            neighbors += " " + std::to_string(path[i + 1]);
+            count++;
+        }
+
+        adjacencies[path[i]] = std::to_string(count) + neighbors + "\n";
+    }
+
+    std::string text = "n\n8\n";
+    for (const std::string& line : adjacencies)
+        text += line;
+    text += "1 2 1 2 1 2 1 2";
+
+    MonotonicArena arena;
+    std::istringstream input(text);
+    Graph* graph = Graph::BuildFromIoStream(input, &arena);
+    std::string ordered = graph->OrderedVertices();
+
+    VertexRelabeler relabeler(graph->GetVertices());
+    CHECK(relabeler.Bandwidth(relabeler.ComputeOrder(RELABEL_NONE)) == 5);
+    CHECK(relabeler.Bandwidth(relabeler.ComputeOrder(RELABEL_RCM)) == 1);
+    CHECK(relabeler.Bandwidth(relabeler.ComputeOrder(RELABEL_BFS)) <= 2);
+
+    graph->Relabel(RELABEL_RCM);
+
+    // Neighbors in the path are neighbors in memory, while the list and the answer keep the original ids
+    std::vector<Vertex*> layout;
+    for (int i = 0; i < graph->VertexCount(); i++)
+    {
+        CHECK(graph->GetVertex(i)->GetId() == i);
+        layout.push_back(graph->GetVertex(i));
+    }
+
+    std::sort(layout.begin(), layout.end(), std::less<Vertex*>());
+    for (size_t i = 0; i + 1 < layout.size(); i++)
+        CHECK(layout[i]->IsAdjacent(layout[i + 1]));
+
+    CHECK(graph->IsGreedy());
+    CHECK(graph->OrderedVertices() == ordered);
+
+    delete graph;
+}
+
+TEST_CASE("Relabeled graphs give the same answers in every order")
+{
+    MonotonicArena arena;
+
+    for (GraphModel model : { ERDOS_RENYI, POWER_LAW, GRID })
+    {
+        for (bool broken : { false, true })
+        {
+            GraphGenerator generator(model, 600, 8, 3);
+            if (broken)
+                generator.BreakGreedy();
+
+            // Every sort method, including the ones whose result depends on the order of the list ('y')
+            for (char sortOption : std::string(SORT_OPTIONS) + AUTO_ORDERER_OPTION)
+            {
+                Graph* original = generator.BuildGraph(sortOption);
+                std::string ordered = original->OrderedVertices();
+
+                for (RelabelOrder order : { RELABEL_NONE, RELABEL_DEGREE, RELABEL_BFS, RELABEL_RCM })
+                {
+                    Graph* relabeled = generator.BuildGraph(sortOption, order == RELABEL_RCM ? &arena : nullptr);
+                    relabeled->Relabel(order);
+
+                    CHECK(relabeled->VertexCount() == original->VertexCount());
+                    CHECK(relabeled->EdgeCount() == original->EdgeCount());
+                    CHECK(relabeled->IsGreedy() == !broken);
+                    CHECK(relabeled->OrderedVertices() == ordered);
+
+                    delete relabeled;
+                }
+
+                delete original;
+            }
+        }
+    }
+
+    // case_50 is sorted with 'y', which does not fully sort, so any change in the list order changes its answer
+    std::ifstream file("tests//Inputs//case_50.txt");
+    REQUIRE(file.is_open());
+
+    std::stringstream content;
+    content << file.rdbuf();
+
+    for (RelabelOrder order : { RELABEL_DEGREE, RELABEL_BFS, RELABEL_RCM })
+    {
+        std::istringstream originalInput(content.str()), relabeledInput(content.str());
+        Graph* original = Graph::BuildFromIoStream(originalInput);
+        Graph* relabeled = Graph::BuildFromIoStream(relabeledInput);
+        relabeled->Relabel(order);
+
+        CHECK(relabeled->OrderedVertices() == original->OrderedVertices());
+
+        delete relabeled;
+        delete original;
+    }
+
+    CHECK(VertexRelabeler::ParseOrder(VertexRelabeler::OrderName(RELABEL_RCM)) == RELABEL_RCM);
+    CHECK_THROWS_AS(VertexRelabeler::ParseOrder("metis"), invalid_relabel_order_exception);
+}
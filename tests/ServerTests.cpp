@@ -0,0 +1,82 @@
+#include <string>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/socket.h>
+
+#include "../third_party/doctest.h"
+#include "GraphServer.hpp"
+
+std::string ReadInputFile(std::string testCase)
+{
+    std::ifstream input("tests//Inputs//" + testCase + ".txt");
+    REQUIRE(input.is_open());
+
+    std::stringstream content;
+    content << input.rdbuf();
+
+    // The last number of a request must be followed by whitespace, otherwise the server waits for more digits
+    return content.str() + "\n";
+}
+
+int ConnectToServer(std::string socketPath)
+{
+    int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    REQUIRE(client >= 0);
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath.c_str());
+
+    REQUIRE(connect(client, (sockaddr*)&address, sizeof(address)) == 0);
+
+    return client;
+}
+
+std::string Request(int client, std::string content, int lines)
+{
+    REQUIRE(write(client, content.data(), content.size()) == (ssize_t)content.size());
+
+    std::string response;
+    char character;
+    while (lines > 0 && read(client, &character, 1) == 1)
+    {
+        response += character;
+
+        if (character == '\n')
+            lines--;
+    }
+
+    return response;
+}
+
+TEST_CASE("Server answers graphs sent through a Unix domain socket")
+{
+    std::string socketPath = "/tmp/graph_server_test_" + std::to_string(getpid()) + ".sock";
+
+    GraphServer server(socketPath.c_str(), 2);
+    server.Start();
+
+    int first = ConnectToServer(socketPath);
+    int second = ConnectToServer(socketPath);
+
+    CHECK(Request(first, ReadInputFile("05"), 1) == "1 1 2 4 5 6 3 7 8 9 0\n");
+    CHECK(Request(second, ReadInputFile("02") + ReadInputFile("03"), 2) == "0\n1 0 2 1 4 3\n");
+    CHECK(Request(first, ReadInputFile("big"), 1).compare(0, 2, "1 ") == 0);
+
+    CHECK(server.RequestCount() == 4);
+    CHECK(server.LatencyPercentile(50) > 0);
+    CHECK(server.LatencyPercentile(99) >= server.LatencyPercentile(50));
+    CHECK(server.LatencyPercentile(100) >= server.LatencyPercentile(99));
+    CHECK(Request(first, "#stats\n", 1).compare(0, 11, "requests 4 ") == 0);
+
+    CHECK(Request(second, "x 1\n0\n1\n", 1) == "O método de ordenação escolhido é inválido!\n");
+
+    close(first);
+    close(second);
+    server.Stop();
+
+    CHECK(access(socketPath.c_str(), F_OK) != 0);
+}
@@ -0,0 +1,103 @@
+#include "../third_party/doctest.h"
+#include "Graph.hpp"
+#include "GraphGenerator.hpp"
+#include "SharedGraph.hpp"
+#include "ShardedVerifier.hpp"
+
+TEST_CASE("Sharded verification agrees with the graph")
+{
+    for (GraphModel model : { ERDOS_RENYI, POWER_LAW, GRID })
+    {
+        for (bool broken : { false, true })
+        {
+            GraphGenerator generator(model, 3000, 6, 11);
+            if (broken)
+                generator.BreakGreedy();
+
+            Graph* graph = generator.BuildGraph('a');
+            SharedGraph shared(graph);
+
+            for (int processCount : { 1, 3, 8 })
+            {
+                ShardedVerifier verifier(shared, processCount);
+
+                CHECK(verifier.Run() == graph->IsGreedy());
+                CHECK(verifier.Run() == !broken);
+                CHECK((shared.FailedId() != -1) == broken);
+                CHECK(verifier.PinnedCount() == 0);
+            }
+
+            delete graph;
+        }
+    }
+}
+
+TEST_CASE("Shards cover every vertex in order")
+{
+    GraphGenerator generator(POWER_LAW, 1000, 10, 5);
+    Graph* graph = generator.BuildGraph('a');
+    SharedGraph shared(graph);
+
+    CHECK(shared.VertexCount() == 1000);
+    CHECK(shared.MaxDegree() > 10);
+
+    std::vector<int> starts = shared.SplitShards(4);
+    REQUIRE(starts.size() == 5);
+    CHECK(starts.front() == 0);
+    CHECK(starts.back() == 1000);
+
+    for (size_t i = 1; i < starts.size(); i++)
+        CHECK(starts[i - 1] <= starts[i]);
+
+    // More processes than vertices leave the extra shards empty
+    std::vector<int> tiny = shared.SplitShards(2000);
+    CHECK(tiny.back() == 1000);
+    CHECK(ShardedVerifier(shared, 2000).Run() == graph->IsGreedy());
+
+    delete graph;
+}
+
+TEST_CASE("Failures are recorded once and reset between runs")
+{
+    GraphGenerator generator(ERDOS_RENYI, 20000, 4, 9);
+    for (int i = 0; i < 50; i++)
+        generator.BreakGreedy();
+
+    Graph* graph = generator.BuildGraph('a');
+    SharedGraph shared(graph);
+
+    shared.RecordFailure(3);
+    shared.RecordFailure(7);
+    CHECK(shared.StopFlag().load() == 1);
+    CHECK(shared.FailedId() == graph->GetVertex(3)->GetId());
+
+    shared.ResetFailure();
+    CHECK(shared.StopFlag().load() == 0);
+    CHECK(shared.FailedId() == -1);
+
+    // Only the workers that found no failure of their own can have stopped early
+    ShardedVerifier verifier(shared, 4);
+    CHECK_FALSE(verifier.Run());
+    CHECK(shared.FailedId() != -1);
+    CHECK(verifier.StoppedCount() < 4);
+
+    delete graph;
+}
+
+TEST_CASE("NUMA nodes are read from the system")
+{
+    std::vector<std::vector<int>> nodes = ShardedVerifier::NumaNodes();
+
+    for (const std::vector<int>& node : nodes)
+        CHECK_FALSE(node.empty());
+
+    GraphGenerator generator(GRID, 500, 8, 2);
+    Graph* graph = generator.BuildGraph('a');
+    SharedGraph shared(graph);
+
+    ShardedVerifier verifier(shared, 2, true);
+    CHECK(verifier.Run());
+    CHECK(verifier.PinnedCount() == (nodes.empty() ? 0 : 2));
+
+    delete graph;
+}
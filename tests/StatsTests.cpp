@@ -0,0 +1,75 @@
+#include <string>
+#include <sstream>
+
+#include "../third_party/doctest.h"
+#include "Stats.hpp"
+#include "LinkedList.hpp"
+#include "GraphOrderer.hpp"
+#include "PerfCounters.hpp"
+
+TEST_CASE("Hardware counters are read or reported as unavailable")
+{
+    PerfCounters counters;
+    long long before[PERF_EVENT_COUNT], after[PERF_EVENT_COUNT];
+
+    counters.Read(before);
+
+    volatile long long sum = 0;
+    for (int i = 0; i < 100000; i++)
+        sum += i;
+
+    counters.Read(after);
+
+    for (int i = 0; i < PERF_EVENT_COUNT; i++)
+    {
+        CHECK((before[i] == PERF_UNAVAILABLE) == (after[i] == PERF_UNAVAILABLE));
+        CHECK(std::string(PerfCounters::EventName((PerfEvent)i)) != "unknown");
+    }
+
+    if (after[PERF_INSTRUCTIONS] != PERF_UNAVAILABLE)
+        CHECK(after[PERF_INSTRUCTIONS] - before[PERF_INSTRUCTIONS] > 100000);
+}
+
+#ifdef GRAPH_STATS
+
+TEST_CASE("Statistics count the operations of each phase")
+{
+    Stats::Clear();
+
+    LinkedList<Vertex*>* list = new LinkedList<Vertex*>();
+    for (int i = 0; i < 20; i++)
+    {
+        Vertex* vertex = new Vertex(19 - i);
+        vertex->SetColor(1);
+        list->Insert(vertex);
+    }
+
+    {
+        STATS_PHASE("walk");
+
+        list->Get(10);
+        list->Get(11);
+        list->Get(10);
+        list->Get(2);
+    }
+
+    GraphOrderer orderer('n');
+    orderer.Sort(list);
+
+    std::stringstream report, trace;
+    Stats::WriteReport(report);
+    Stats::WriteTrace(trace);
+
+    CHECK(report.str().find("walk 1 ") != std::string::npos);
+    CHECK(report.str().find("sort:n 1 ") != std::string::npos);
+    CHECK(trace.str().find("\"cursor_hits\": 2, \"linear_walks\": 2, \"walk_length\": 12") != std::string::npos);
+    CHECK(trace.str().find("\"name\": \"sort:n\"") != std::string::npos);
+
+    for (int i = 0; i < list->Length(); i++)
+        delete list->Get(i);
+
+    delete list;
+    Stats::Clear();
+}
+
+#endif
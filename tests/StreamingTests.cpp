@@ -0,0 +1,152 @@
+#include <string>
+#include <random>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <unistd.h>
+
+#include "../third_party/doctest.h"
+#include "GraphRunner.hpp"
+#include "GraphGenerator.hpp"
+#include "StreamingVerifier.hpp"
+#include "MappedFileStream.hpp"
+#include "FileDescriptorStream.hpp"
+#include "OutputWriter.hpp"
+
+/**
+ * Returns the answer of the graph built from the input and of the streaming verifier, in this order.
+ */
+std::pair<std::string, std::string> AnswerBothWays(const std::string& input, int firstCount = -1)
+{
+    std::string built, streamed;
+    {
+        OutputWriter builtOutput(built), streamedOutput(streamed);
+        std::istringstream builtInput(input), streamedInput(input);
+
+        GraphRunner::Run(builtInput, builtOutput, firstCount);
+        StreamingVerifier::Run(streamedInput, streamedOutput, firstCount);
+    }
+
+    return { built, streamed };
+}
+
+TEST_CASE("Streaming verification answers the inputs as the built graph")
+{
+    for (std::string testCase : { "01", "02", "03", "04", "05", "06", "07", "08", "09", "10", "11", "12", "13", "14", "big", "case_50", "disc", "try" })
+    {
+        std::ifstream file("tests//Inputs//" + testCase + ".txt");
+        REQUIRE(file.is_open());
+
+        std::stringstream content;
+        content << file.rdbuf();
+
+        for (int firstCount : { -1, 0, 3 })
+        {
+            std::pair<std::string, std::string> answers = AnswerBothWays(content.str(), firstCount);
+            CHECK(answers.second == answers.first);
+        }
+    }
+
+    for (GraphModel model : { ERDOS_RENYI, POWER_LAW, DENSE, GRID })
+    {
+        for (int broken : { 0, 1 })
+        {
+            GraphGenerator generator(model, 500, 6, 12);
+            if (broken)
+                generator.BreakGreedy();
+
+            for (char sortOption : { 'q', 'y', 'a' })
+            {
+                std::string text;
+                {
+                    OutputWriter output(text);
+                    generator.Write(output, sortOption);
+                }
+
+                std::pair<std::string, std::string> answers = AnswerBothWays(text);
+                CHECK(answers.first[0] == (broken ? '0' : '1'));
+                CHECK(answers.second == answers.first);
+            }
+        }
+    }
+}
+
+TEST_CASE("Streaming verification reports the same error as the built graph")
+{
+    std::ifstream file("tests//Inputs//05.txt");
+    REQUIRE(file.is_open());
+
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string text = content.str();
+
+    // Every truncation of the input
+    for (size_t length = 0; length <= text.size(); length++)
+    {
+        std::pair<std::string, std::string> answers = AnswerBothWays(text.substr(0, length));
+        CHECK(answers.second == answers.first);
+    }
+
+    // Tokens replaced by ids out of range, negative colors, colors of neighbors and garbage
+    std::mt19937 random(21);
+    const char* replacements[] = { "-1", "0", "1", "2", "3", "7", "12345", "x", "+4" };
+
+    for (int i = 0; i < 400; i++)
+    {
+        std::string changed = text;
+        size_t position = random() % changed.size();
+
+        while (position < changed.size() && (changed[position] == ' ' || changed[position] == '\n'))
+            position++;
+
+        size_t end = changed.find_first_of(" \n", position);
+        if (position >= changed.size() || end == std::string::npos)
+            continue;
+
+        changed.replace(position, end - position, replacements[random() % 9]);
+
+        std::pair<std::string, std::string> answers = AnswerBothWays(changed);
+        CHECK(answers.second == answers.first);
+    }
+}
+
+TEST_CASE("Mapped files can be read more than once and pipes are refused")
+{
+    std::string path = "tests//Inputs//05.txt";
+    MappedFileStreamBuffer buffer(path.c_str());
+    std::istream input(&buffer);
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    CHECK(buffer.Size() == content.str().size());
+
+    std::string answer;
+    {
+        OutputWriter output(answer);
+        CHECK(StreamingVerifier::Run(input, output));
+    }
+
+    CHECK(answer == AnswerBothWays(content.str()).first);
+
+    CHECK_THROWS_AS(MappedFileStreamBuffer("tests//Inputs//missing.txt"), mapped_file_exception);
+    CHECK_THROWS_AS(MappedFileStreamBuffer("tests//Inputs"), mapped_file_exception);
+
+    // A stream without positions cannot be verified in two passes
+    int pipeEnds[2];
+    REQUIRE(pipe(pipeEnds) == 0);
+    REQUIRE(write(pipeEnds[1], content.str().data(), content.str().size()) == (ssize_t)content.str().size());
+    close(pipeEnds[1]);
+
+    FileDescriptorStreamBuffer pipeBuffer(pipeEnds[0]);
+    std::istream pipeInput(&pipeBuffer);
+
+    std::string refused;
+    {
+        OutputWriter output(refused);
+        CHECK_FALSE(StreamingVerifier::Run(pipeInput, output));
+    }
+
+    CHECK(refused == "A entrada não pode ser lida novamente na verificação em duas passagens!\n");
+    close(pipeEnds[0]);
+}
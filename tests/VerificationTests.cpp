@@ -0,0 +1,85 @@
+#include <vector>
+
+#include "../third_party/doctest.h"
+#include "Graph.hpp"
+#include "GraphGenerator.hpp"
+
+/**
+ * Verifies every vertex in the order of the list, as the graph did before the pre-filters.
+ */
+bool IsGreedyInListOrder(Graph* graph)
+{
+    for (int i = 0; i < graph->VertexCount(); i++)
+    {
+        if (!graph->GetVertex(i)->IsGreedy())
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Builds a star with a center of the given color and leaves of the given colors.
+ */
+Graph* BuildStar(int centerColor, const std::vector<int>& leafColors)
+{
+    Graph* graph = new Graph('a');
+    Vertex* center = graph->CreateVertex(0);
+
+    for (size_t i = 0; i < leafColors.size(); i++)
+    {
+        Vertex* leaf = graph->CreateVertex(i + 1);
+        graph->AddEdge(center, leaf);
+        graph->AddEdge(leaf, center);
+        leaf->SetColor(leafColors[i]);
+    }
+
+    center->SetColor(centerColor);
+    return graph;
+}
+
+TEST_CASE("Pre-filters reject colors above the degree and gaps in the colors")
+{
+    // Color 4 with two neighbors
+    Graph* graph = BuildStar(4, { 1, 2 });
+    CHECK_FALSE(graph->IsGreedy());
+    CHECK_FALSE(IsGreedyInListOrder(graph));
+    delete graph;
+
+    // Color 3 is used and no vertex has color 2
+    graph = BuildStar(3, { 1, 1 });
+    CHECK_FALSE(graph->IsGreedy());
+    CHECK_FALSE(IsGreedyInListOrder(graph));
+    delete graph;
+
+    // Color 0 is never greedy, and it does not count as a smaller color of a neighbor
+    graph = BuildStar(2, { 0, 1 });
+    CHECK_FALSE(graph->IsGreedy());
+    CHECK_FALSE(IsGreedyInListOrder(graph));
+    delete graph;
+
+    graph = BuildStar(2, { 1, 1, 1 });
+    CHECK(graph->IsGreedy());
+    CHECK(graph->GetVertex(0)->IsGreedy());
+    delete graph;
+}
+
+TEST_CASE("Verification in the failure-likely-first order matches the list order")
+{
+    for (GraphModel model : { ERDOS_RENYI, POWER_LAW, DENSE, GRID })
+    {
+        for (int brokenCount : { 0, 1, 5 })
+        {
+            GraphGenerator generator(model, 800, 6, 17 + brokenCount);
+            for (int i = 0; i < brokenCount; i++)
+                generator.BreakGreedy();
+
+            Graph* graph = generator.BuildGraph('a');
+
+            CHECK(graph->IsGreedy() == (brokenCount == 0));
+            CHECK(graph->IsGreedy() == IsGreedyInListOrder(graph));
+
+            delete graph;
+        }
+    }
+}